@@ -26,6 +26,12 @@ class WebSocketService {
   bool _shouldReconnect = false;
   Timer? _reconnectTimer;
 
+  // Last full state with the deltas applied, and the server version it matches.
+  // Null until a full state has arrived on this connection.
+  Map<String, dynamic>? _stateJson;
+  int? _stateSeq;
+  bool _resyncRequested = false;
+
   Future<void> connect(String host, int port) async {
     _lastHost = host;
     _lastPort = port;
@@ -48,6 +54,11 @@ class WebSocketService {
     
     try {
       _channel = WebSocketChannel.connect(uri);
+      _stateJson = null;
+      _stateSeq = null;
+      _resyncRequested = false;
+      // Ask for state deltas; older servers ignore this and keep sending full states
+      _channel!.sink.add(jsonEncode({'command': 'hello', 'stateDeltas': true}));
       
       _channel!.stream.listen((message) {
         if (_status != ConnectionStatus.connected) {
@@ -64,9 +75,13 @@ class WebSocketService {
             _teamsController.add(teams);
           } else if (data.containsKey('type') && data['type'] == 'image') {
             _imageController.add(data);
+          } else if (data.containsKey('type') && data['type'] == 'stateDelta') {
+            _applyStateDelta(data);
           } else if (data.containsKey('homeScore')) { // Likely ScoreboardState
-            final state = ScoreboardState.fromJson(data);
-            _stateController.add(state);
+            _stateJson = data;
+            _stateSeq = data['seq'] as int?;
+            _resyncRequested = false;
+            _stateController.add(ScoreboardState.fromJson(data));
           }
         } catch (e) {
           print('Error parsing message: $e');
@@ -84,6 +99,28 @@ class WebSocketService {
     }
   }
 
+  // A delta applies on top of any version from 'base' up to (not including) 'seq': the
+  // server only skips versions with no visible change, and 'changes' holds whole field
+  // values. A base newer than our version means a message was missed (or arrived before
+  // the full state), so ask for the whole state again.
+  void _applyStateDelta(Map<String, dynamic> data) {
+    final seq = data['seq'] as int;
+    final base = data['base'] as int;
+    if (_stateJson == null || _stateSeq == null) return; // Full state still on its way
+    if (seq <= _stateSeq!) return; // Already included in the state we have
+    if (base > _stateSeq!) {
+      if (!_resyncRequested) {
+        _resyncRequested = true;
+        _channel?.sink.add(jsonEncode({'command': 'getState'}));
+      }
+      return;
+    }
+
+    _stateJson = {..._stateJson!, ...(data['changes'] as Map<String, dynamic>)};
+    _stateSeq = seq;
+    _stateController.add(ScoreboardState.fromJson(_stateJson!));
+  }
+
   void _scheduleReconnect() {
     if (!_shouldReconnect) return;
     
@@ -0,0 +1,132 @@
+#include "AllocationTracker.h"
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cerrno>
+
+namespace {
+
+struct alignas(64) SubsystemCounters {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> bytes{0};
+};
+
+std::array<SubsystemCounters, AllocationTracker::SUBSYSTEM_COUNT> g_counters;
+thread_local AllocationSubsystem t_subsystem = AllocationSubsystem::Other;
+
+void countAllocation(const size_t size) {
+    SubsystemCounters& counters = g_counters[static_cast<size_t>(t_subsystem)];
+    counters.count.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+}
+
+// --- Interposition ---
+//
+// Blend2D allocates with malloc, not operator new, so the malloc family itself is
+// interposed (glibc) to see allocations from the renderers *and* their libraries.
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+
+void* malloc(size_t size) {
+    countAllocation(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    countAllocation(count * size);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    countAllocation(size);
+    return __libc_realloc(ptr, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    countAllocation(size);
+    return __libc_memalign(alignment, size);
+}
+
+void* memalign(size_t alignment, size_t size) {
+    countAllocation(size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) {
+    countAllocation(size);
+    void* ptr = __libc_memalign(alignment, size);
+    if (!ptr) return ENOMEM;
+    *out = ptr;
+    return 0;
+}
+}
+#else
+// Elsewhere only C++ allocations can be seen
+#include <new>
+
+void* operator new(size_t size) {
+    countAllocation(size);
+    if (void* ptr = std::malloc(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+#endif
+
+// --- AllocationTracker ---
+
+uint64_t AllocationTracker::count(const AllocationSubsystem subsystem) {
+    return g_counters[static_cast<size_t>(subsystem)].count.load(std::memory_order_relaxed);
+}
+
+uint64_t AllocationTracker::bytes(const AllocationSubsystem subsystem) {
+    return g_counters[static_cast<size_t>(subsystem)].bytes.load(std::memory_order_relaxed);
+}
+
+uint64_t AllocationTracker::totalCount() {
+    uint64_t total = 0;
+    for (const auto& counters : g_counters) total += counters.count.load(std::memory_order_relaxed);
+    return total;
+}
+
+uint64_t AllocationTracker::totalBytes() {
+    uint64_t total = 0;
+    for (const auto& counters : g_counters) total += counters.bytes.load(std::memory_order_relaxed);
+    return total;
+}
+
+const char* AllocationTracker::name(const AllocationSubsystem subsystem) {
+    switch (subsystem) {
+        case AllocationSubsystem::Other: return "other";
+        case AllocationSubsystem::Update: return "update";
+        case AllocationSubsystem::Render: return "render";
+        case AllocationSubsystem::Display: return "display";
+        case AllocationSubsystem::Network: return "network";
+        case AllocationSubsystem::Count: break;
+    }
+    return "other";
+}
+
+// --- AllocationScope ---
+
+AllocationScope::AllocationScope(const AllocationSubsystem subsystem) : previous(t_subsystem) {
+    t_subsystem = subsystem;
+}
+
+AllocationScope::~AllocationScope() {
+    t_subsystem = previous;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Counts heap allocations per subsystem. Linking AllocationTracker.cpp interposes the
+// malloc family (glibc; operator new elsewhere), so allocations made inside Blend2D and
+// other libraries are seen too. Each allocation is attributed to the subsystem of the
+// innermost AllocationScope on the allocating thread, or to Other.
+//
+// Counting is two relaxed atomic adds per allocation. The controller exports the totals
+// as metrics; puckpulse-bench uses them for allocations per iteration and --check-zero-alloc.
+
+enum class AllocationSubsystem : uint8_t { Other, Update, Render, Display, Network, Count };
+
+class AllocationTracker {
+public:
+    static constexpr size_t SUBSYSTEM_COUNT = static_cast<size_t>(AllocationSubsystem::Count);
+
+    [[nodiscard]] static uint64_t count(AllocationSubsystem subsystem);
+    [[nodiscard]] static uint64_t bytes(AllocationSubsystem subsystem);
+    [[nodiscard]] static uint64_t totalCount();
+    [[nodiscard]] static uint64_t totalBytes();
+
+    // "other", "update", "render", "display" or "network"
+    [[nodiscard]] static const char* name(AllocationSubsystem subsystem);
+};
+
+// Attributes this thread's allocations to a subsystem for the lifetime of the scope
+class AllocationScope {
+public:
+    explicit AllocationScope(AllocationSubsystem subsystem);
+    ~AllocationScope();
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+private:
+    AllocationSubsystem previous;
+};
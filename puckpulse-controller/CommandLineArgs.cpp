@@ -1,5 +1,8 @@
 #include "CommandLineArgs.h"
 #include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <ctime>
 
 CommandLineArgs::CommandLineArgs(const int argc, char* argv[]) {
     parseArgs(argc, argv);
@@ -18,6 +21,62 @@ void CommandLineArgs::parseArgs(const int argc, char* argv[]) {
             if (i + 1 < argc && argv[i+1][0] != '-') {
                 m_colorLightInterface = argv[++i];
             }
+        } else if ((arg == "-d" || arg == "--ddp") && i + 1 < argc) {
+            m_enableDDP = true;
+            std::string target = argv[++i];
+            auto colon = target.find(':');
+            if (colon != std::string::npos) {
+                m_ddpPort = static_cast<uint16_t>(std::stoi(target.substr(colon + 1)));
+                target = target.substr(0, colon);
+            }
+            m_ddpHost = target;
+        } else if (arg == "-f" || arg == "--frame-ring") {
+            m_enableFrameRing = true;
+            if (i + 1 < argc && argv[i+1][0] == '/') {
+                m_frameRingName = argv[++i];
+            }
+        } else if (arg == "--realtime") {
+            m_enableRealtime = true;
+            if (i + 1 < argc && argv[i+1][0] != '-') {
+                m_realtimePriority = std::stoi(argv[++i]);
+            }
+        } else if (arg == "--cpu" && i + 1 < argc) {
+            m_cpu = std::stoi(argv[++i]);
+        } else if (arg == "--jitter") {
+            m_reportJitter = true;
+        } else if (arg == "--record") {
+            m_enableRecording = true;
+            if (i + 1 < argc && argv[i+1][0] != '-') {
+                m_recordingDir = argv[++i];
+            }
+        } else if (arg == "--replay" && i + 1 < argc) {
+            m_replay = true;
+            m_replayFromMs = parseTimestampMs(argv[++i]);
+            if (i + 1 < argc && argv[i+1][0] != '-') {
+                m_replayToMs = parseTimestampMs(argv[++i]);
+            }
+        } else if (arg == "--http-port" && i + 1 < argc) {
+            m_httpPort = std::stoi(argv[++i]);
+        } else if (arg == "--trace") {
+            m_enableTracing = true;
+            if (i + 1 < argc && argv[i+1][0] != '-') {
+                m_traceDir = argv[++i];
+            }
+        } else if (arg == "--log-level" && i + 1 < argc) {
+            if (!Log::parseLevel(argv[++i], m_logLevel)) {
+                std::cerr << "Unknown log level '" << argv[i] << "'. Use debug, info, warn or error." << std::endl;
+            }
+        } else if (arg == "--diagnostics") {
+            m_showDiagnostics = true;
+        } else if (arg == "--soak") {
+            m_soak = true;
+            if (i + 1 < argc && argv[i+1][0] != '-') {
+                m_soakSeconds = parseDurationSeconds(argv[++i]);
+            }
+        } else if (arg == "--soak-pattern" && i + 1 < argc) {
+            m_soakPattern = argv[++i];
+        } else if (arg == "--soak-fps" && i + 1 < argc) {
+            m_soakMaxFps = std::stoi(argv[++i]);
         } else if (arg == "-h" || arg == "--help") {
             m_showHelp = true;
             return; // Stop parsing if help is requested
@@ -25,6 +84,35 @@ void CommandLineArgs::parseArgs(const int argc, char* argv[]) {
     }
 }
 
+// Accepts Unix seconds or local time as YYYY-MM-DDTHH:MM:SS
+uint64_t CommandLineArgs::parseTimestampMs(const std::string& value) {
+    if (!value.empty() && value.find_first_not_of("0123456789") == std::string::npos) {
+        return std::stoull(value) * 1000;
+    }
+
+    std::tm tm{};
+    std::istringstream in(value);
+    in >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%S");
+    if (in.fail()) {
+        std::cerr << "Invalid time '" << value << "'. Use Unix seconds or YYYY-MM-DDTHH:MM:SS." << std::endl;
+        return 0;
+    }
+    tm.tm_isdst = -1;
+    return static_cast<uint64_t>(std::mktime(&tm)) * 1000;
+}
+
+// Seconds, or a number with an s, m or h suffix (e.g. 90m, 8h)
+uint64_t CommandLineArgs::parseDurationSeconds(const std::string& value) {
+    size_t digits = 0;
+    const uint64_t amount = std::stoull(value, &digits);
+    const std::string unit = value.substr(digits);
+    if (unit.empty() || unit == "s") return amount;
+    if (unit == "m") return amount * 60;
+    if (unit == "h") return amount * 3600;
+    std::cerr << "Invalid duration '" << value << "'. Use seconds or a number with s, m or h." << std::endl;
+    return 0;
+}
+
 void CommandLineArgs::printHelp(const char* appName) const {
     std::cout << "Usage: " << appName << " [OPTIONS]" << std::endl;
 #ifdef ENABLE_SFML
@@ -32,5 +120,25 @@ void CommandLineArgs::printHelp(const char* appName) const {
 #endif
     std::cout << "  -c, --colorlight [interface] Enable ColorLight display (default: disabled). "
               << "Optionally specify network interface, e.g., -c eth0" << std::endl;
+    std::cout << "  -d, --ddp <host[:port]> Enable DDP output to a WLED/Falcon pixel controller (default port: 4048)" << std::endl;
+    std::cout << "  -f, --frame-ring [/name] Publish frames to a shared-memory ring for puckpulse-display-driver "
+              << "(default: /puckpulse-frames)" << std::endl;
+    std::cout << "      --realtime [priority] Run the render/output loop with SCHED_FIFO (default priority: 50) "
+              << "and lock memory" << std::endl;
+    std::cout << "      --cpu <n>          Pin the render/output loop to this CPU core" << std::endl;
+    std::cout << "      --jitter           Print the frame-send jitter histogram at exit (any time: kill -USR1)" << std::endl;
+    std::cout << "      --record [dir]     Record every displayed frame to a rolling log (default: <data dir>/recordings)" << std::endl;
+    std::cout << "      --replay <from> [to] Play back recorded frames on the enabled displays and exit. "
+              << "Times are Unix seconds or YYYY-MM-DDTHH:MM:SS" << std::endl;
+    std::cout << "      --http-port <n>    Port for the HTTP endpoint serving /metrics and the player photos at "
+              << "/images/<sha256> that the teams list names (default: 9001, 0 disables both)" << std::endl;
+    std::cout << "      --trace [dir]      Record a Chrome/Perfetto trace; dump with kill -USR2 (to dir, default: "
+              << "<data dir>/traces) or GET /trace" << std::endl;
+    std::cout << "      --log-level <level> Minimum log level: debug, info, warn or error (default: info)" << std::endl;
+    std::cout << "      --diagnostics      Start with the diagnostic overlay (render time, fps, packets, clients) on the board" << std::endl;
+    std::cout << "      --soak [duration]  Stress every configured display with test patterns as fast as it goes and "
+              << "report fps, transmit time, drops and CPU; runs until interrupted unless a duration (e.g. 8h) is given" << std::endl;
+    std::cout << "      --soak-pattern <name> Soak pattern: gradient, bars, white or cycle (default: cycle)" << std::endl;
+    std::cout << "      --soak-fps <n>     Cap the soak frame rate (default: uncapped)" << std::endl;
     std::cout << "  -h, --help         Show this help message" << std::endl;
 }
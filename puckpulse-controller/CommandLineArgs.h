@@ -2,6 +2,8 @@
 
 #include <string>
 #include <vector>
+#include <cstdint>
+#include "Log.h"
 
 class CommandLineArgs {
 public:
@@ -10,6 +12,29 @@ public:
     [[nodiscard]] bool enableSFML() const { return m_enableSFML; }
     [[nodiscard]] bool enableColorLight() const { return m_enableColorLight; }
     [[nodiscard]] const std::string& colorLightInterface() const { return m_colorLightInterface; }
+    [[nodiscard]] bool enableDDP() const { return m_enableDDP; }
+    [[nodiscard]] const std::string& ddpHost() const { return m_ddpHost; }
+    [[nodiscard]] uint16_t ddpPort() const { return m_ddpPort; }
+    [[nodiscard]] bool enableFrameRing() const { return m_enableFrameRing; }
+    [[nodiscard]] const std::string& frameRingName() const { return m_frameRingName; }
+    [[nodiscard]] bool enableRealtime() const { return m_enableRealtime; }
+    [[nodiscard]] int realtimePriority() const { return m_realtimePriority; }
+    [[nodiscard]] int cpu() const { return m_cpu; }
+    [[nodiscard]] bool reportJitter() const { return m_reportJitter; }
+    [[nodiscard]] bool enableRecording() const { return m_enableRecording; }
+    [[nodiscard]] const std::string& recordingDir() const { return m_recordingDir; }
+    [[nodiscard]] bool replay() const { return m_replay; }
+    [[nodiscard]] uint64_t replayFromMs() const { return m_replayFromMs; }
+    [[nodiscard]] uint64_t replayToMs() const { return m_replayToMs; }
+    [[nodiscard]] int httpPort() const { return m_httpPort; }
+    [[nodiscard]] bool enableTracing() const { return m_enableTracing; }
+    [[nodiscard]] const std::string& traceDir() const { return m_traceDir; }
+    [[nodiscard]] LogLevel logLevel() const { return m_logLevel; }
+    [[nodiscard]] bool showDiagnostics() const { return m_showDiagnostics; }
+    [[nodiscard]] bool soak() const { return m_soak; }
+    [[nodiscard]] uint64_t soakSeconds() const { return m_soakSeconds; }
+    [[nodiscard]] const std::string& soakPattern() const { return m_soakPattern; }
+    [[nodiscard]] int soakMaxFps() const { return m_soakMaxFps; }
     [[nodiscard]] bool showHelp() const { return m_showHelp; }
     void printHelp(const char* appName) const;
 
@@ -17,7 +42,32 @@ private:
     bool m_enableSFML = false;
     bool m_enableColorLight = false;
     std::string m_colorLightInterface = "enx00e04c68012e";
+    bool m_enableDDP = false;
+    std::string m_ddpHost;
+    uint16_t m_ddpPort = 4048;
+    bool m_enableFrameRing = false;
+    std::string m_frameRingName = "/puckpulse-frames";
+    bool m_enableRealtime = false;
+    int m_realtimePriority = 50;
+    int m_cpu = -1;
+    bool m_reportJitter = false;
+    bool m_enableRecording = false;
+    std::string m_recordingDir; // Empty: <data dir>/recordings
+    bool m_replay = false;
+    uint64_t m_replayFromMs = 0;
+    uint64_t m_replayToMs = UINT64_MAX;
+    int m_httpPort = 9001; // 0: disabled
+    bool m_enableTracing = false;
+    std::string m_traceDir; // Empty: <data dir>/traces
+    LogLevel m_logLevel = LogLevel::Info;
+    bool m_showDiagnostics = false;
+    bool m_soak = false;
+    uint64_t m_soakSeconds = 0; // 0: until interrupted
+    std::string m_soakPattern = "cycle";
+    int m_soakMaxFps = 0; // 0: as fast as the displays go
     bool m_showHelp = false;
 
     void parseArgs(int argc, char* argv[]);
+    static uint64_t parseTimestampMs(const std::string& value);
+    static uint64_t parseDurationSeconds(const std::string& value);
 };
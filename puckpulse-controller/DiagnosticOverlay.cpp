@@ -0,0 +1,127 @@
+#include "DiagnosticOverlay.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+DiagnosticOverlay::DiagnosticOverlay(DoubleFramebuffer& dfb, const ResourceLocator& resourceLocator, SampleSource sampleSource)
+    : dfb(dfb), sampleSource(std::move(sampleSource)), target(dfb) {
+    const std::string path = resourceLocator.getFontsDirPath() + "/digital-7 (mono).ttf";
+    BLResult err = fontFace.createFromFile(path.c_str());
+    if (err) {
+        std::cerr << "Failed to load font from path: " << path << " (Error: " << err << ")" << std::endl;
+    } else {
+        font.createFromFace(fontFace, 13.0f);
+    }
+
+    layer.create(PANEL_WIDTH, dfb.getHeight(), BL_FORMAT_PRGB32);
+    layerContext.begin(layer);
+}
+
+void DiagnosticOverlay::setEnabled(const bool enabled) {
+    if (m_enabled.exchange(enabled, std::memory_order_relaxed) != enabled) {
+        m_changed.store(true, std::memory_order_relaxed);
+    }
+}
+
+void DiagnosticOverlay::toggle() {
+    bool enabled = m_enabled.load(std::memory_order_relaxed);
+    while (!m_enabled.compare_exchange_weak(enabled, !enabled, std::memory_order_relaxed)) {
+    }
+    m_changed.store(true, std::memory_order_relaxed);
+}
+
+bool DiagnosticOverlay::needsFrame(const std::chrono::steady_clock::time_point now) const {
+    return m_changed.load(std::memory_order_relaxed) || (enabled() && now >= nextRefresh);
+}
+
+void DiagnosticOverlay::compose(const std::chrono::steady_clock::time_point now) {
+    const bool changed = m_changed.exchange(false, std::memory_order_relaxed);
+    if (!enabled()) return;
+
+    if (changed) {
+        // Rates are taken over one interval from switching on, not since it was last on
+        hasPrevious = false;
+        nextRefresh = now;
+    }
+    if (now >= nextRefresh) {
+        refresh(now);
+        nextRefresh = now + REFRESH_INTERVAL;
+    }
+
+    BLContext* context = target.begin();
+    if (!context) return;
+    context->blitImage(BLPointI(0, 0), layer, BLRectI(0, 0, PANEL_WIDTH, layerHeight));
+    target.end(*context);
+}
+
+void DiagnosticOverlay::drawLine(const int line, const std::string_view text) {
+    const double baseline = PADDING + (line + 1) * LINE_HEIGHT - 2;
+    gb.setUtf8Text(text.data(), text.size());
+    font.shape(gb);
+    layerContext.fillGlyphRun(BLPoint(PADDING, baseline), font, gb.glyphRun());
+}
+
+// Formats into fixed buffers and reuses the glyph buffer, so a refresh doesn't allocate
+void DiagnosticOverlay::refresh(const std::chrono::steady_clock::time_point now) {
+    DiagnosticSample current;
+    sampleSource(current);
+    current.displayCount = std::min(current.displayCount, DiagnosticSample::MAX_DISPLAYS);
+
+    const double seconds = hasPrevious ? std::chrono::duration<double>(now - previousTime).count() : 0.0;
+    const size_t lines = 3 + current.displayCount;
+    layerHeight = std::min(static_cast<int>(lines) * LINE_HEIGHT + 2 * PADDING, dfb.getHeight());
+
+    layerContext.clearAll();
+    layerContext.setFillStyle(BLRgba32(0, 0, 0, 200));
+    layerContext.fillRect(BLRectI(0, 0, PANEL_WIDTH, layerHeight));
+    layerContext.setFillStyle(BLRgba32(0, 255, 0));
+
+    char text[64];
+    auto line = [&](const int index, const int length) {
+        drawLine(index, std::string_view(text, static_cast<size_t>(std::clamp(length, 0, static_cast<int>(sizeof(text)) - 1))));
+    };
+
+    if (hasPrevious && current.renders > previous.renders) {
+        const double renderMs = static_cast<double>(current.renderNs - previous.renderNs)
+            / static_cast<double>(current.renders - previous.renders) / 1e6;
+        line(0, std::snprintf(text, sizeof(text), "RENDER %.2f MS", renderMs));
+    } else {
+        line(0, std::snprintf(text, sizeof(text), "RENDER --"));
+    }
+
+    line(1, std::snprintf(text, sizeof(text), "CLIENTS %d", current.clients));
+
+    if (current.lastCommand) {
+        line(2, std::snprintf(text, sizeof(text), "CMD %s %.2f MS", current.lastCommand,
+                              static_cast<double>(current.lastCommandNs) / 1e6));
+    } else {
+        line(2, std::snprintf(text, sizeof(text), "CMD --"));
+    }
+
+    for (size_t i = 0; i < current.displayCount; ++i) {
+        const DiagnosticSample::Display& display = current.displays[i];
+        const int index = static_cast<int>(3 + i);
+        const bool comparable = hasPrevious && i < previous.displayCount && seconds > 0.0
+            && previous.displays[i].name == display.name;
+        if (!comparable) {
+            line(index, std::snprintf(text, sizeof(text), "%-8.8s -- FPS", display.name ? display.name : "?"));
+            continue;
+        }
+
+        const uint64_t frames = display.frames - previous.displays[i].frames;
+        const uint64_t packets = display.packets - previous.displays[i].packets;
+        const double fps = static_cast<double>(frames) / seconds;
+        if (frames > 0) {
+            line(index, std::snprintf(text, sizeof(text), "%-8.8s %5.1f FPS %6.1f PKT/F", display.name, fps,
+                                      static_cast<double>(packets) / static_cast<double>(frames)));
+        } else {
+            line(index, std::snprintf(text, sizeof(text), "%-8.8s %5.1f FPS", display.name, fps));
+        }
+    }
+
+    layerContext.flush(BL_CONTEXT_FLUSH_SYNC);
+
+    previous = current;
+    previousTime = now;
+    hasPrevious = true;
+}
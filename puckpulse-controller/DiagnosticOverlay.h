@@ -0,0 +1,87 @@
+#pragma once
+
+#include <blend2d.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include "display/DoubleFramebuffer.h"
+#include "ResourceLocator.h"
+#include "RenderTarget.h"
+
+// Running totals the overlay turns into rates; filled in by whoever owns the metrics
+struct DiagnosticSample {
+    static constexpr size_t MAX_DISPLAYS = 8;
+
+    struct Display {
+        const char* name = nullptr;
+        uint64_t frames = 0;  // output() calls
+        uint64_t packets = 0; // IDisplay::packetsSent()
+    };
+
+    uint64_t renders = 0;
+    uint64_t renderNs = 0; // Total time spent rendering
+    std::array<Display, MAX_DISPLAYS> displays{};
+    size_t displayCount = 0;
+    int clients = 0;
+    const char* lastCommand = nullptr; // nullptr before the first command
+    uint64_t lastCommandNs = 0;
+};
+
+// Commissioning HUD drawn over whatever scene is on the board: render time, output fps and
+// packets per frame for each display, connected clients and the latency of the last command.
+//
+// The text is drawn into a cached layer at most every REFRESH_INTERVAL; every other frame
+// only blits that layer, so switching the overlay on barely moves the numbers it reports.
+// While it is on the board is redrawn at least at that interval, even with the clock stopped.
+class DiagnosticOverlay {
+public:
+    using SampleSource = std::function<void(DiagnosticSample&)>;
+
+    static constexpr auto REFRESH_INTERVAL = std::chrono::milliseconds(500);
+
+    DiagnosticOverlay(DoubleFramebuffer& dfb, const ResourceLocator& resourceLocator, SampleSource sampleSource);
+
+    // Safe to call from any thread (WebSocket command, keyboard)
+    void setEnabled(bool enabled);
+    void toggle();
+    [[nodiscard]] bool enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    // True when a frame is needed although the scoreboard hasn't changed: the numbers are due
+    // for a refresh, or the overlay was just switched on or off
+    [[nodiscard]] bool needsFrame(std::chrono::steady_clock::time_point now) const;
+
+    // Draws the overlay over the scene in the back buffer; call after the scene renderer and
+    // before the swap
+    void compose(std::chrono::steady_clock::time_point now);
+
+private:
+    static constexpr int PANEL_WIDTH = 200;
+    static constexpr int LINE_HEIGHT = 12;
+    static constexpr int PADDING = 3;
+
+    DoubleFramebuffer& dfb;
+    SampleSource sampleSource;
+
+    std::atomic<bool> m_enabled{false};
+    std::atomic<bool> m_changed{false};
+
+    // Main thread only
+    std::chrono::steady_clock::time_point nextRefresh{};
+    DiagnosticSample previous;
+    std::chrono::steady_clock::time_point previousTime{};
+    bool hasPrevious = false;
+
+    BLFontFace fontFace;
+    BLFont font;
+    BLGlyphBuffer gb;
+    BLImage layer;
+    BLContext layerContext;
+    int layerHeight = 0;
+    RenderTarget target;
+
+    void refresh(std::chrono::steady_clock::time_point now);
+    void drawLine(int line, std::string_view text);
+};
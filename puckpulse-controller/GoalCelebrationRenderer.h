@@ -1,21 +1,29 @@
 #pragma once
 
 #include "IRenderer.h"
+#include "RenderTarget.h"
 #include "display/DoubleFramebuffer.h"
 #include "ResourceLocator.h"
-#include "ScoreboardController.h"
+#include "ScoreboardSnapshot.h"
 #include <blend2d.h>
+#include <chrono>
+#include <functional>
+#include <string_view>
 
 class GoalCelebrationRenderer : public IRenderer {
 public:
-    explicit GoalCelebrationRenderer(DoubleFramebuffer& dfb, const ResourceLocator& resourceLocator, const ScoreboardController& controller);
+    // Drives the "GOAL!" blink; tests pass a fixed time to get repeatable frames
+    using Clock = std::function<std::chrono::steady_clock::time_point()>;
 
-    void render() const override;
+    explicit GoalCelebrationRenderer(DoubleFramebuffer& dfb, const ResourceLocator& resourceLocator,
+                                     Clock clock = std::chrono::steady_clock::now);
+
+    void render(const ScoreboardSnapshot& snapshot) const override;
 
 private:
     DoubleFramebuffer& dfb;
     const ResourceLocator& _resourceLocator;
-    const ScoreboardController& controller;
+    Clock clock;
 
     BLFontFace fontFace;
     BLFont titleFont;
@@ -24,4 +32,15 @@ private:
     BLRgba32 colorWhite{255, 255, 255};
     BLRgba32 colorOrange{255, 170, 51};
     BLRgba32 colorRed{255, 0, 0};
+
+    // Reused every frame so steady-state rendering doesn't allocate; the player photo is
+    // decoded once per goal rather than once per frame
+    mutable RenderTarget target;
+    mutable BLGlyphBuffer gb;
+    mutable BLImage playerImage;
+    mutable uint64_t playerImageGeneration = UINT64_MAX;
+
+    const BLImage* decodedPlayerImage(const ScoreboardSnapshot& snapshot) const;
+    [[nodiscard]] double textWidth(const BLFont& textFont, std::string_view text) const;
+    void drawText(BLContext& ctx, const BLPoint& origin, const BLFont& textFont, std::string_view text) const;
 };
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "ScoreboardSnapshot.h"
+
 class IRenderer {
 public:
     virtual ~IRenderer() = default;
-    virtual void render() const = 0;
+    // Draws one frame of the given state into the back buffer
+    virtual void render(const ScoreboardSnapshot& snapshot) const = 0;
 };
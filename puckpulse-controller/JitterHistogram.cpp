@@ -0,0 +1,46 @@
+#include "JitterHistogram.h"
+#include <iomanip>
+#include <string>
+
+void JitterHistogram::record(const std::chrono::steady_clock::duration lateness) {
+    int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(lateness).count();
+    if (us < 0) us = 0; // Early counts as on time
+
+    size_t bucket = 0;
+    while (bucket < BUCKET_LIMITS_US.size() && us >= BUCKET_LIMITS_US[bucket]) {
+        bucket++;
+    }
+    buckets[bucket]++;
+    total++;
+    sumUs += us;
+    if (us > maxUs) maxUs = us;
+}
+
+void JitterHistogram::print(std::ostream& out, const char* title) const {
+    out << title << " (" << total << " samples";
+    if (total > 0) {
+        out << ", mean " << (sumUs / static_cast<int64_t>(total)) << " us, max " << maxUs << " us";
+    }
+    out << ")" << std::endl;
+    if (total == 0) return;
+
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        std::string label = (i < BUCKET_LIMITS_US.size())
+            ? "< " + std::to_string(BUCKET_LIMITS_US[i]) + " us"
+            : ">= " + std::to_string(BUCKET_LIMITS_US.back()) + " us";
+
+        double percent = 100.0 * static_cast<double>(buckets[i]) / static_cast<double>(total);
+        int barLength = static_cast<int>(percent / 2.0);
+
+        out << "  " << std::setw(12) << std::left << label << std::right
+            << std::setw(10) << buckets[i] << std::setw(8) << std::fixed << std::setprecision(2) << percent << "% "
+            << std::string(barLength, '#') << std::endl;
+    }
+}
+
+void JitterHistogram::reset() {
+    buckets.fill(0);
+    total = 0;
+    maxUs = 0;
+    sumUs = 0;
+}
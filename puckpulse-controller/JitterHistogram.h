@@ -0,0 +1,27 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+// Records how late events happen relative to their scheduled time (e.g. frame sends vs.
+// the main loop tick deadline) into fixed log-spaced buckets. Recording is a couple of
+// compares and an increment, so it can stay on in the hot path.
+class JitterHistogram {
+public:
+    void record(std::chrono::steady_clock::duration lateness);
+    void print(std::ostream& out, const char* title) const;
+    void reset();
+
+    [[nodiscard]] uint64_t count() const { return total; }
+
+private:
+    // Upper bounds in microseconds; the last bucket catches everything above
+    static constexpr std::array<int64_t, 10> BUCKET_LIMITS_US = {50, 100, 250, 500, 1000, 2000, 5000, 10000, 20000, 50000};
+
+    std::array<uint64_t, BUCKET_LIMITS_US.size() + 1> buckets{};
+    uint64_t total = 0;
+    int64_t maxUs = 0;
+    int64_t sumUs = 0;
+};
@@ -6,10 +6,10 @@ const std::vector<std::string> KeyboardControl::TEAM_NAMES = {
     "MAMBAS", "BREAKERS", "EAGLES", "TIGERS", "SHARKS", "WOLVES", "LIONS", "STARS", "CANUCKS", "PANTHERS"
 };
 
-KeyboardControl::KeyboardControl(ScoreboardController& controller)
-    : scoreboard(controller) {
-    scoreboard.setHomeTeamName(TEAM_NAMES[homeNameIdx]);
-    scoreboard.setAwayTeamName(TEAM_NAMES[awayNameIdx]);
+KeyboardControl::KeyboardControl(ScoreboardController& controller, DiagnosticOverlay& overlay)
+    : scoreboard(controller), overlay(overlay) {
+    scoreboard.submit(commands::SetHomeTeamName{TEAM_NAMES[homeNameIdx]});
+    scoreboard.submit(commands::SetAwayTeamName{TEAM_NAMES[awayNameIdx]});
 }
 
 void KeyboardControl::handleInput(sf::RenderWindow& window) {
@@ -19,55 +19,58 @@ void KeyboardControl::handleInput(sf::RenderWindow& window) {
         } else if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
             switch (keyPressed->code) {
                 case sf::Keyboard::Key::Space:
-                    scoreboard.toggleClock();
+                    scoreboard.submit(commands::ToggleClock{});
                     break;
                 case sf::Keyboard::Key::C:
-                    scoreboard.setClockMode(ClockMode::TimeOfDay);
+                    scoreboard.submit(commands::SetClockMode{ClockMode::TimeOfDay});
                     break;
                 case sf::Keyboard::Key::S:
                     // Stop clock
                     if (scoreboard.getState().isClockRunning) {
-                        scoreboard.toggleClock();
+                        scoreboard.submit(commands::ToggleClock{});
                     }
                     break;
                 case sf::Keyboard::Key::R:
                     // Resume Running
-                    scoreboard.setClockMode(ClockMode::Game);
+                    scoreboard.submit(commands::SetClockMode{ClockMode::Game});
                     if (!scoreboard.getState().isClockRunning) {
-                        scoreboard.toggleClock();
+                        scoreboard.submit(commands::ToggleClock{});
                     }
                     break;
                 case sf::Keyboard::Key::Num1:
-                    scoreboard.addHomeScore(1);
+                    scoreboard.submit(commands::AddHomeScore{1});
                     break;
                 case sf::Keyboard::Key::Num2:
-                    scoreboard.addAwayScore(1);
+                    scoreboard.submit(commands::AddAwayScore{1});
                     break;
                 case sf::Keyboard::Key::Num3:
-                    scoreboard.addHomeShots(1);
+                    scoreboard.submit(commands::AddHomeShots{1});
                     break;
                 case sf::Keyboard::Key::Num4:
-                    scoreboard.addAwayShots(1);
+                    scoreboard.submit(commands::AddAwayShots{1});
                     break;
                 case sf::Keyboard::Key::H:
-                    scoreboard.addHomePenalty(120, 22);
+                    scoreboard.submit(commands::AddHomePenalty{120, 22});
                     break;
                 case sf::Keyboard::Key::A:
-                    scoreboard.addAwayPenalty(120, 33);
+                    scoreboard.submit(commands::AddAwayPenalty{120, 33});
                     break;
                 case sf::Keyboard::Key::P:
-                    scoreboard.nextPeriod();
+                    scoreboard.submit(commands::NextPeriod{});
                     break;
                 case sf::Keyboard::Key::X:
-                    scoreboard.resetGame();
+                    scoreboard.submit(commands::ResetGame{});
                     break;
                 case sf::Keyboard::Key::T:
                     homeNameIdx = (homeNameIdx + 1) % TEAM_NAMES.size();
-                    scoreboard.setHomeTeamName(TEAM_NAMES[homeNameIdx]);
+                    scoreboard.submit(commands::SetHomeTeamName{TEAM_NAMES[homeNameIdx]});
                     break;
                 case sf::Keyboard::Key::Y:
                     awayNameIdx = (awayNameIdx + 1) % TEAM_NAMES.size();
-                    scoreboard.setAwayTeamName(TEAM_NAMES[awayNameIdx]);
+                    scoreboard.submit(commands::SetAwayTeamName{TEAM_NAMES[awayNameIdx]});
+                    break;
+                case sf::Keyboard::Key::D:
+                    overlay.toggle();
                     break;
                 default:
                     break;
@@ -93,5 +96,6 @@ void KeyboardControl::printInstructions() const {
     std::cout << "  [R]     Resume Running" << std::endl;
     std::cout << "  [S]     Stop Clock" << std::endl;
     std::cout << "  [X]     Reset Game" << std::endl;
+    std::cout << "  [D]     Toggle Diagnostic Overlay" << std::endl;
     std::cout << "------------------------------------------" << std::endl;
 }
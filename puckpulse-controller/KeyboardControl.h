@@ -4,16 +4,18 @@
 #include <string>
 #include <vector>
 #include "ScoreboardController.h"
+#include "DiagnosticOverlay.h"
 
 class KeyboardControl {
 public:
-    KeyboardControl(ScoreboardController& controller);
+    KeyboardControl(ScoreboardController& controller, DiagnosticOverlay& overlay);
 
     void handleInput(sf::RenderWindow& window);
     void printInstructions() const;
 
 private:
     ScoreboardController& scoreboard;
+    DiagnosticOverlay& overlay;
     
     size_t homeNameIdx = 0;
     size_t awayNameIdx = 1;
@@ -0,0 +1,292 @@
+#include "Log.h"
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <mutex>
+#include <thread>
+
+std::atomic<LogLevel> Log::s_level{LogLevel::Info};
+
+namespace {
+
+// One line in the ring. A bounded MPSC queue in the style of Vyukov's: `sequence` says
+// whether the record is free for the producer claiming position p (== p), holds a line
+// for the writer (== p + 1), or is still waiting for the writer's previous lap.
+struct Record {
+    std::atomic<uint64_t> sequence{0};
+    uint64_t unixMs = 0;
+    LogLevel level = LogLevel::Info;
+    uint16_t length = 0;
+    char text[Log::LINE_CAPACITY];
+};
+
+struct Ring {
+    std::array<Record, Log::RING_CAPACITY> records;
+    alignas(64) std::atomic<uint64_t> tail{0}; // Next position producers claim
+    alignas(64) uint64_t head = 0;             // Next position the writer reads
+    std::atomic<uint64_t> dropped{0};
+
+    Ring() {
+        for (size_t i = 0; i < records.size(); ++i) {
+            records[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+};
+
+// Never destroyed: other threads may still log while the process exits
+Ring& ring() {
+    static auto* instance = new Ring;
+    return *instance;
+}
+
+std::atomic<bool> running{false};
+std::atomic<bool> stopping{false};
+std::mutex lifecycleMutex;
+std::thread* writerThread = nullptr; // Not a global std::thread: exit() while it runs must not terminate()
+std::mutex syncMutex;
+thread_local char syncText[Log::LINE_CAPACITY];
+
+uint64_t unixMsNow() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+// journald reads an sd-daemon "<priority>" prefix and adds its own timestamps; a terminal
+// gets a local timestamp instead
+bool underJournald() {
+    static const bool journald = std::getenv("JOURNAL_STREAM") != nullptr;
+    return journald;
+}
+
+void appendLine(std::string& out, const LogLevel level, const uint64_t unixMs, const std::string_view text) {
+    if (underJournald()) {
+        static constexpr const char* PRIORITIES[] = {"<7>", "<6>", "<4>", "<3>"};
+        out += PRIORITIES[static_cast<int>(level)];
+    } else {
+        const std::time_t seconds = static_cast<std::time_t>(unixMs / 1000);
+        std::tm local{};
+        localtime_r(&seconds, &local);
+        char stamp[32];
+        const size_t n = std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%S", &local);
+        out.append(stamp, n);
+        const auto ms = static_cast<unsigned>(unixMs % 1000);
+        out += '.';
+        out += static_cast<char>('0' + ms / 100);
+        out += static_cast<char>('0' + ms / 10 % 10);
+        out += static_cast<char>('0' + ms % 10);
+        out += ' ';
+    }
+    out += text;
+    out += '\n';
+}
+
+void flush(std::string& batch) {
+    if (batch.empty()) return;
+    std::fwrite(batch.data(), 1, batch.size(), stdout);
+    std::fflush(stdout);
+    batch.clear();
+}
+
+void writerLoop() {
+    Ring& r = ring();
+    std::string batch;
+    batch.reserve(64 * 1024);
+    uint64_t reportedDrops = 0;
+
+    while (true) {
+        const bool finalPass = stopping.load(std::memory_order_acquire);
+
+        while (true) {
+            Record& record = r.records[r.head % Log::RING_CAPACITY];
+            if (record.sequence.load(std::memory_order_acquire) != r.head + 1) break;
+            appendLine(batch, record.level, record.unixMs, std::string_view(record.text, record.length));
+            record.sequence.store(r.head + Log::RING_CAPACITY, std::memory_order_release);
+            r.head++;
+        }
+
+        if (const uint64_t drops = r.dropped.load(std::memory_order_relaxed); drops != reportedDrops) {
+            char text[Log::LINE_CAPACITY];
+            LogLine line(text, sizeof(text));
+            line.field("level", "warn");
+            line.field("component", "log");
+            line.field("msg", "Log ring full, lines dropped");
+            line.field("dropped", drops - reportedDrops);
+            appendLine(batch, LogLevel::Warn, unixMsNow(), std::string_view(text, line.size()));
+            reportedDrops = drops;
+        }
+
+        flush(batch);
+        if (finalPass) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+}
+
+bool needsQuotes(const std::string_view value) {
+    if (value.empty()) return true;
+    for (const char c : value) {
+        if (c == ' ' || c == '=' || c == '"' || static_cast<unsigned char>(c) < 0x20) return true;
+    }
+    return false;
+}
+
+}
+
+// --- LogSite ---
+
+bool LogSite::allow() {
+    const auto second = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+
+    uint64_t window = windowSecond.load(std::memory_order_relaxed);
+    if (window != second && windowSecond.compare_exchange_strong(window, second, std::memory_order_relaxed)) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    if (count.fetch_add(1, std::memory_order_relaxed) < LINES_PER_SECOND) {
+        return true;
+    }
+    suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+// --- LogLine ---
+
+void LogLine::append(const std::string_view text) {
+    const size_t n = std::min(text.size(), capacity - length);
+    std::memcpy(buffer + length, text.data(), n);
+    length += n;
+}
+
+void LogLine::append(const char c) {
+    if (length < capacity) buffer[length++] = c;
+}
+
+void LogLine::beginField(const std::string_view key) {
+    if (length > 0) append(' ');
+    append(key);
+    append('=');
+}
+
+void LogLine::field(const std::string_view key, const std::string_view value) {
+    beginField(key);
+    if (!needsQuotes(value)) {
+        append(value);
+        return;
+    }
+    append('"');
+    for (const char c : value) {
+        if (c == '"' || c == '\\') {
+            append('\\');
+            append(c);
+        } else if (c == '\n') {
+            append("\\n");
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            append(' ');
+        } else {
+            append(c);
+        }
+    }
+    append('"');
+}
+
+void LogLine::field(const std::string_view key, const bool value) {
+    beginField(key);
+    append(value ? "true" : "false");
+}
+
+void LogLine::field(const std::string_view key, const double value) {
+    beginField(key);
+    char digits[32];
+    auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::general, 6);
+    append(std::string_view(digits, static_cast<size_t>(end - digits)));
+}
+
+// --- Log ---
+
+void Log::start() {
+    std::lock_guard lock(lifecycleMutex);
+    if (running.load(std::memory_order_relaxed)) return;
+    ring(); // Allocate before the first line needs it
+    stopping.store(false, std::memory_order_relaxed);
+    writerThread = new std::thread(writerLoop);
+    running.store(true, std::memory_order_release);
+}
+
+void Log::stop() {
+    std::lock_guard lock(lifecycleMutex);
+    if (!running.load(std::memory_order_relaxed)) return;
+    running.store(false, std::memory_order_release); // New lines go out synchronously
+    stopping.store(true, std::memory_order_release);
+    writerThread->join();
+    delete writerThread;
+    writerThread = nullptr;
+}
+
+bool Log::parseLevel(const std::string_view name, LogLevel& level) {
+    static constexpr std::pair<std::string_view, LogLevel> LEVELS[] = {
+        {"debug", LogLevel::Debug}, {"info", LogLevel::Info}, {"warn", LogLevel::Warn}, {"error", LogLevel::Error},
+    };
+    for (const auto& [levelName, value] : LEVELS) {
+        if (name == levelName) {
+            level = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t Log::dropped() {
+    return ring().dropped.load(std::memory_order_relaxed);
+}
+
+const char* Log::levelName(const LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug: return "debug";
+        case LogLevel::Info: return "info";
+        case LogLevel::Warn: return "warn";
+        case LogLevel::Error: return "error";
+    }
+    return "info";
+}
+
+Log::Slot Log::claim(const LogLevel level) {
+    if (!running.load(std::memory_order_acquire)) {
+        return {nullptr, syncText, level};
+    }
+
+    Ring& r = ring();
+    uint64_t position = r.tail.load(std::memory_order_relaxed);
+    while (true) {
+        Record& record = r.records[position % RING_CAPACITY];
+        const uint64_t sequence = record.sequence.load(std::memory_order_acquire);
+        if (sequence == position) {
+            if (r.tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                return {&record, record.text, level};
+            }
+        } else if (sequence < position) {
+            r.dropped.fetch_add(1, std::memory_order_relaxed); // The writer is a full lap behind
+            return {nullptr, nullptr, level};
+        } else {
+            position = r.tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Log::publish(const Slot& slot, const size_t length) {
+    if (!slot.record) {
+        std::string line;
+        appendLine(line, slot.level, unixMsNow(), std::string_view(slot.text, length));
+        std::lock_guard lock(syncMutex);
+        std::fwrite(line.data(), 1, line.size(), stdout);
+        std::fflush(stdout);
+        return;
+    }
+
+    auto* record = static_cast<Record*>(slot.record);
+    record->unixMs = unixMsNow();
+    record->level = slot.level;
+    record->length = static_cast<uint16_t>(length);
+    const uint64_t position = record->sequence.load(std::memory_order_relaxed);
+    record->sequence.store(position + 1, std::memory_order_release);
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <atomic>
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+// Asynchronous structured logging for the WebSocket, team and preview threads.
+//
+//   LOG_INFO("ws", "Received command", "command", cmd, "bytes", msg->str.size());
+//
+// produces one logfmt line on stdout:
+//
+//   level=info component=ws msg="Received command" command=getTeams bytes=24
+//
+// A log call formats straight into a slot of a fixed-size lock-free ring and returns; a
+// background thread writes the lines out in batches, so callers never wait on stdout or
+// journald. When the ring is full the line is dropped and counted rather than blocking.
+// Under systemd (JOURNAL_STREAM set) lines carry a <N> priority prefix so journald
+// records the level; on a terminal they start with a timestamp instead.
+//
+// Every call site is rate limited on its own (LogSite::LINES_PER_SECOND); the number of
+// lines it suppressed is attached to the next line it lets through.
+
+enum class LogLevel : uint8_t { Debug, Info, Warn, Error };
+
+class LogSite {
+public:
+    static constexpr uint32_t LINES_PER_SECOND = 20;
+
+    // False when this site has already logged LINES_PER_SECOND lines in the current second
+    bool allow();
+    uint32_t takeSuppressed() { return suppressed.exchange(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> windowSecond{0};
+    std::atomic<uint32_t> count{0};
+    std::atomic<uint32_t> suppressed{0};
+};
+
+// Appends logfmt key=value pairs to a fixed buffer, truncating (never allocating)
+class LogLine {
+public:
+    LogLine(char* buffer, size_t capacity) : buffer(buffer), capacity(capacity) {}
+
+    void field(std::string_view key, std::string_view value);
+    void field(const std::string_view key, const std::string& value) { field(key, std::string_view(value)); }
+    void field(const std::string_view key, const char* value) { field(key, std::string_view(value ? value : "")); }
+    void field(std::string_view key, bool value);
+    void field(std::string_view key, double value);
+    template <std::integral T>
+    void field(const std::string_view key, const T value) {
+        beginField(key);
+        char digits[24];
+        auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+        append(std::string_view(digits, static_cast<size_t>(end - digits)));
+    }
+
+    [[nodiscard]] size_t size() const { return length; }
+
+private:
+    char* buffer;
+    size_t capacity;
+    size_t length = 0;
+
+    void beginField(std::string_view key);
+    void append(std::string_view text);
+    void append(char c);
+};
+
+class Log {
+public:
+    // Longer lines are truncated
+    static constexpr size_t LINE_CAPACITY = 240;
+    static constexpr size_t RING_CAPACITY = 1024;
+
+    // Starts the writer thread. Until then (and after stop()) lines are written synchronously,
+    // so startup messages and tools that never start it still log.
+    static void start();
+    // Writes out everything queued and stops the writer thread
+    static void stop();
+
+    static void setLevel(LogLevel level) { s_level.store(level, std::memory_order_relaxed); }
+    [[nodiscard]] static bool enabled(const LogLevel level) { return level >= s_level.load(std::memory_order_relaxed); }
+    // "debug", "info", "warn" or "error"
+    static bool parseLevel(std::string_view name, LogLevel& level);
+
+    // Lines lost because the ring was full
+    [[nodiscard]] static uint64_t dropped();
+
+    // Fields are alternating keys and values; use the LOG_* macros, which add the rate limit
+    template <typename... Fields>
+    static void write(const LogLevel level, const char* component, LogSite& site, const std::string_view message,
+                      const Fields&... fields) {
+        static_assert(sizeof...(Fields) % 2 == 0, "log fields are key/value pairs");
+        Slot slot = claim(level);
+        if (!slot.text) return; // Ring full
+        LogLine line(slot.text, LINE_CAPACITY);
+        line.field("level", levelName(level));
+        line.field("component", component);
+        line.field("msg", message);
+        if constexpr (sizeof...(Fields) > 0) {
+            appendFields(line, fields...);
+        }
+        if (const uint32_t suppressed = site.takeSuppressed(); suppressed > 0) {
+            line.field("suppressed", suppressed);
+        }
+        publish(slot, line.size());
+    }
+
+private:
+    struct Slot {
+        void* record; // Ring record, or nullptr when writing synchronously
+        char* text;   // nullptr when the line is dropped
+        LogLevel level;
+    };
+
+    static std::atomic<LogLevel> s_level;
+
+    static const char* levelName(LogLevel level);
+    static Slot claim(LogLevel level);
+    static void publish(const Slot& slot, size_t length);
+
+    template <typename Value, typename... Rest>
+    static void appendFields(LogLine& line, const std::string_view key, const Value& value, const Rest&... rest) {
+        line.field(key, value);
+        if constexpr (sizeof...(Rest) > 0) {
+            appendFields(line, rest...);
+        }
+    }
+};
+
+#define LOG_AT(level, component, ...)                                          \
+    do {                                                                       \
+        static LogSite logSite_;                                               \
+        if (Log::enabled(level) && logSite_.allow()) {                         \
+            Log::write(level, component, logSite_, __VA_ARGS__);              \
+        }                                                                      \
+    } while (0)
+
+#define LOG_DEBUG(component, ...) LOG_AT(LogLevel::Debug, component, __VA_ARGS__)
+#define LOG_INFO(component, ...) LOG_AT(LogLevel::Info, component, __VA_ARGS__)
+#define LOG_WARN(component, ...) LOG_AT(LogLevel::Warn, component, __VA_ARGS__)
+#define LOG_ERROR(component, ...) LOG_AT(LogLevel::Error, component, __VA_ARGS__)
@@ -0,0 +1,191 @@
+#include "Metrics.h"
+#include <algorithm>
+#include <bit>
+#include <sstream>
+
+// --- LatencyHistogram ---
+
+size_t LatencyHistogram::bucketFor(const uint64_t ns) {
+    if (ns < SUB_COUNT) return ns;
+    const int msb = std::bit_width(ns) - 1;
+    if (msb > MAX_MSB) return BUCKET_COUNT - 1;
+    const int shift = msb - SUB_BITS;
+    return (shift + 1) * SUB_COUNT + ((ns >> shift) & (SUB_COUNT - 1));
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(const size_t bucket) {
+    if (bucket < SUB_COUNT) return bucket;
+    const size_t shift = bucket / SUB_COUNT - 1;
+    const uint64_t sub = bucket % SUB_COUNT;
+    return ((SUB_COUNT + sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(const std::chrono::steady_clock::duration duration) {
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    recordNs(ns > 0 ? static_cast<uint64_t>(ns) : 0);
+}
+
+void LatencyHistogram::recordNs(const uint64_t ns) {
+    buckets[bucketFor(ns)].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(ns, std::memory_order_relaxed);
+    last.store(ns, std::memory_order_relaxed);
+
+    uint64_t previous = max.load(std::memory_order_relaxed);
+    while (ns > previous && !max.compare_exchange_weak(previous, ns, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t LatencyHistogram::percentileNs(const double quantile) const {
+    const uint64_t n = count();
+    if (n == 0) return 0;
+
+    const auto rank = static_cast<uint64_t>(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(n - 1)) + 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(bucketUpperBound(i), maxNs());
+        }
+    }
+    return maxNs();
+}
+
+// --- Metrics ---
+
+Metrics::Entry* Metrics::find(const std::string& name, const std::string& labelValue) const {
+    for (const auto& entry : entries) {
+        if (entry->name == name && entry->labelValue == labelValue) return entry.get();
+    }
+    return nullptr;
+}
+
+Counter& Metrics::counter(const std::string& name, const std::string& help,
+                          const std::string& labelName, const std::string& labelValue) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry* entry = find(name, labelValue);
+    if (!entry) {
+        entries.push_back(std::make_unique<Entry>(Entry{name, help, labelName, labelValue, std::make_unique<Counter>(), nullptr, nullptr}));
+        entry = entries.back().get();
+    }
+    return *entry->counter;
+}
+
+LatencyHistogram& Metrics::histogram(const std::string& name, const std::string& help,
+                                     const std::string& labelName, const std::string& labelValue) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry* entry = find(name, labelValue);
+    if (!entry) {
+        entries.push_back(std::make_unique<Entry>(Entry{name, help, labelName, labelValue, nullptr, std::make_unique<LatencyHistogram>(), nullptr}));
+        entry = entries.back().get();
+    }
+    return *entry->histogram;
+}
+
+void Metrics::addFunction(const std::string& name, const std::string& help, std::function<double()> read,
+                          const std::string& labelName, const std::string& labelValue, const bool monotonic) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry* entry = find(name, labelValue);
+    if (!entry) {
+        entries.push_back(std::make_unique<Entry>(Entry{name, help, labelName, labelValue, nullptr, nullptr, nullptr}));
+        entry = entries.back().get();
+    }
+    entry->read = std::move(read);
+    entry->monotonic = monotonic;
+}
+
+void Metrics::gauge(const std::string& name, const std::string& help, std::function<double()> read,
+                    const std::string& labelName, const std::string& labelValue) {
+    addFunction(name, help, std::move(read), labelName, labelValue, false);
+}
+
+void Metrics::counterFunction(const std::string& name, const std::string& help, std::function<double()> read,
+                              const std::string& labelName, const std::string& labelValue) {
+    addFunction(name, help, std::move(read), labelName, labelValue, true);
+}
+
+nlohmann::json Metrics::toJson() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    nlohmann::json j = nlohmann::json::object();
+    for (const auto& entry : entries) {
+        nlohmann::json value;
+        if (entry->counter) {
+            value = entry->counter->get();
+        } else if (entry->histogram) {
+            const LatencyHistogram& h = *entry->histogram;
+            const uint64_t n = h.count();
+            value = {
+                {"count", n},
+                {"meanUs", n > 0 ? static_cast<double>(h.sumNs()) / n / 1000.0 : 0.0},
+                {"p50Us", h.percentileNs(0.50) / 1000.0},
+                {"p99Us", h.percentileNs(0.99) / 1000.0},
+                {"p999Us", h.percentileNs(0.999) / 1000.0},
+                {"maxUs", h.maxNs() / 1000.0},
+            };
+        } else if (entry->read) {
+            value = entry->read();
+        }
+
+        if (entry->labelValue.empty()) {
+            j[entry->name] = value;
+        } else {
+            j[entry->name][entry->labelValue] = value;
+        }
+    }
+    return j;
+}
+
+static std::string escapeLabel(const std::string& value) {
+    std::string out;
+    for (char c : value) {
+        if (c == '\\' || c == '"') out += '\\';
+        if (c == '\n') { out += "\\n"; continue; }
+        out += c;
+    }
+    return out;
+}
+
+std::string Metrics::toPrometheus() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // HELP/TYPE are written once per metric name, so group labelled series together
+    std::vector<const Entry*> sorted;
+    for (const auto& entry : entries) sorted.push_back(entry.get());
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Entry* a, const Entry* b) { return a->name < b->name; });
+
+    std::ostringstream out;
+    const std::string* lastName = nullptr;
+    for (const Entry* entry : sorted) {
+        const std::string label = entry->labelName.empty()
+            ? std::string()
+            : entry->labelName + "=\"" + escapeLabel(entry->labelValue) + "\"";
+        auto labels = [&label](const std::string& extra = {}) {
+            std::string all = label;
+            if (!extra.empty()) all += (all.empty() ? "" : ",") + extra;
+            return all.empty() ? std::string() : "{" + all + "}";
+        };
+
+        const bool first = !lastName || *lastName != entry->name;
+        lastName = &entry->name;
+
+        if (entry->counter) {
+            if (first) out << "# HELP " << entry->name << " " << entry->help << "\n# TYPE " << entry->name << " counter\n";
+            out << entry->name << labels() << " " << entry->counter->get() << "\n";
+        } else if (entry->histogram) {
+            const LatencyHistogram& h = *entry->histogram;
+            if (first) out << "# HELP " << entry->name << " " << entry->help << "\n# TYPE " << entry->name << " summary\n";
+            for (const char* q : {"0.5", "0.9", "0.99", "0.999"}) {
+                out << entry->name << labels(std::string("quantile=\"") + q + "\"")
+                    << " " << h.percentileNs(std::stod(q)) / 1e9 << "\n";
+            }
+            out << entry->name << "_sum" << labels() << " " << h.sumNs() / 1e9 << "\n";
+            out << entry->name << "_count" << labels() << " " << h.count() << "\n";
+        } else if (entry->read) {
+            if (first) out << "# HELP " << entry->name << " " << entry->help << "\n# TYPE " << entry->name
+                           << (entry->monotonic ? " counter\n" : " gauge\n");
+            out << entry->name << labels() << " " << entry->read() << "\n";
+        }
+    }
+    return out.str();
+}
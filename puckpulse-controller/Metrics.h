@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+// Log-linear (HDR style) latency histogram: every power of two is split into 8 linear
+// sub-buckets, so any recorded value is known to within 12.5% from 1ns up to minutes.
+// record() is a bit_width, a shift and a few relaxed atomic adds; it is safe to call
+// from any thread and cheap enough to leave on in the hot path.
+class LatencyHistogram {
+public:
+    void record(std::chrono::steady_clock::duration duration);
+    void recordNs(uint64_t ns);
+
+    [[nodiscard]] uint64_t count() const { return total.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t sumNs() const { return sum.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t maxNs() const { return max.load(std::memory_order_relaxed); }
+    // Most recently recorded value
+    [[nodiscard]] uint64_t lastNs() const { return last.load(std::memory_order_relaxed); }
+
+    // Upper bound of the bucket holding the given quantile (0..1), in ns
+    [[nodiscard]] uint64_t percentileNs(double quantile) const;
+
+private:
+    static constexpr int SUB_BITS = 3;
+    static constexpr uint64_t SUB_COUNT = 1 << SUB_BITS;
+    static constexpr int MAX_MSB = 40; // ~18 minutes; larger values land in the last bucket
+    static constexpr size_t BUCKET_COUNT = (MAX_MSB - SUB_BITS + 2) * SUB_COUNT;
+
+    static size_t bucketFor(uint64_t ns);
+    static uint64_t bucketUpperBound(size_t bucket);
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets{};
+    std::atomic<uint64_t> total{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> max{0};
+    std::atomic<uint64_t> last{0};
+};
+
+class Counter {
+public:
+    void add(const uint64_t n = 1) { value.fetch_add(n, std::memory_order_relaxed); }
+    void set(const uint64_t n) { value.store(n, std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t get() const { return value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> value{0};
+};
+
+// Records the lifetime of the scope into a histogram
+class ScopedLatency {
+public:
+    explicit ScopedLatency(LatencyHistogram& histogram,
+                           const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now())
+        : histogram(histogram), start(start) {}
+    ~ScopedLatency() { histogram.record(std::chrono::steady_clock::now() - start); }
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+    LatencyHistogram& histogram;
+    std::chrono::steady_clock::time_point start;
+};
+
+// Registry of named counters and histograms, exported as JSON (getStats) and in the
+// Prometheus text format (/metrics). Metrics are identified by a name plus one optional
+// label, e.g. ("puckpulse_stage_seconds", "stage", "render").
+//
+// Registration takes a lock, so hot paths look their metrics up once and keep the
+// reference; the returned objects live as long as the registry.
+class Metrics {
+public:
+    Counter& counter(const std::string& name, const std::string& help,
+                     const std::string& labelName = {}, const std::string& labelValue = {});
+    LatencyHistogram& histogram(const std::string& name, const std::string& help,
+                                const std::string& labelName = {}, const std::string& labelValue = {});
+
+    // Values owned elsewhere and read at export time, e.g. the bytes a display has sent
+    void gauge(const std::string& name, const std::string& help, std::function<double()> read,
+               const std::string& labelName = {}, const std::string& labelValue = {});
+    void counterFunction(const std::string& name, const std::string& help, std::function<double()> read,
+                         const std::string& labelName = {}, const std::string& labelValue = {});
+
+    [[nodiscard]] nlohmann::json toJson() const;
+    [[nodiscard]] std::string toPrometheus() const;
+
+private:
+    struct Entry {
+        std::string name;
+        std::string help;
+        std::string labelName;
+        std::string labelValue;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<LatencyHistogram> histogram;
+        std::function<double()> read;
+        bool monotonic = false; // A read() counter rather than a gauge
+    };
+
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<Entry>> entries;
+
+    Entry* find(const std::string& name, const std::string& labelValue) const;
+    void addFunction(const std::string& name, const std::string& help, std::function<double()> read,
+                     const std::string& labelName, const std::string& labelValue, bool monotonic);
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+// Bounded lock-free multi-producer, single-consumer queue in the style of Vyukov's (the
+// same scheme as the log ring): each slot's `sequence` says whether it is free for the
+// producer claiming position p (== p), holds a value for the consumer (== p + 1), or is
+// still waiting for the consumer's previous lap. push() never blocks; it fails when the
+// consumer is a full lap behind.
+template <typename T, size_t Capacity>
+class MpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+    MpscQueue() {
+        for (size_t i = 0; i < Capacity; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Any thread; false (and value untouched) when the queue is full
+    bool push(T&& value) {
+        uint64_t position = tail.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &slots[position % Capacity];
+            const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+            if (sequence == position) {
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            } else if (sequence < position) {
+                return false;
+            } else {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+        slot->value.emplace(std::move(value));
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only; values come out in the order their push() claimed a slot
+    std::optional<T> pop() {
+        const uint64_t position = head.load(std::memory_order_relaxed);
+        Slot& slot = slots[position % Capacity];
+        if (slot.sequence.load(std::memory_order_acquire) != position + 1) return std::nullopt;
+
+        std::optional<T> value = std::move(slot.value);
+        slot.value.reset();
+        slot.sequence.store(position + Capacity, std::memory_order_release);
+        head.store(position + 1, std::memory_order_relaxed);
+        return value;
+    }
+
+    // Values claimed but not yet popped; approximate while producers are pushing
+    [[nodiscard]] uint64_t size() const {
+        const uint64_t h = head.load(std::memory_order_relaxed);
+        const uint64_t t = tail.load(std::memory_order_relaxed);
+        return t > h ? t - h : 0;
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        std::optional<T> value;
+    };
+
+    std::array<Slot, Capacity> slots;
+    alignas(64) std::atomic<uint64_t> tail{0}; // Next position producers claim
+    alignas(64) std::atomic<uint64_t> head{0}; // Next position the consumer reads; written by it only
+};
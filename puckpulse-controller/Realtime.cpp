@@ -0,0 +1,63 @@
+#include "Realtime.h"
+#include <iostream>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <cerrno>
+#include <sys/mman.h>
+#include <unistd.h>
+
+bool setRealtimePriority(const int priority) {
+    sched_param param{};
+    param.sched_priority = priority;
+    int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (err != 0) {
+        std::cerr << "Failed to set SCHED_FIFO priority " << priority << ": " << strerror(err) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool pinCurrentThreadToCpu(const int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (err != 0) {
+        std::cerr << "Failed to pin thread to CPU " << cpu << ": " << strerror(err) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool resetThreadScheduling() {
+    sched_param param{};
+    int err = pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+    if (err != 0) {
+        std::cerr << "Failed to reset thread scheduling: " << strerror(err) << std::endl;
+        return false;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    // Configured rather than online CPUs, so a gap left by an offline core is still covered;
+    // the kernel ignores the ones it can't run on
+    const long cpus = sysconf(_SC_NPROCESSORS_CONF);
+    for (long cpu = 0; cpu < cpus && cpu < CPU_SETSIZE; ++cpu) {
+        CPU_SET(cpu, &set);
+    }
+    err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (err != 0) {
+        std::cerr << "Failed to reset thread CPU affinity: " << strerror(err) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool lockProcessMemory() {
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        std::cerr << "Failed to lock process memory: " << strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+// Helpers for running latency sensitive threads (LED output) with realtime scheduling.
+// Priority and affinity apply to the calling thread; SCHED_FIFO needs CAP_SYS_NICE (or a
+// suitable RLIMIT_RTPRIO) and locking memory needs CAP_IPC_LOCK (or RLIMIT_MEMLOCK).
+
+// Switch the calling thread to SCHED_FIFO with the given priority (1-99)
+bool setRealtimePriority(int priority);
+
+// Pin the calling thread to a single CPU core
+bool pinCurrentThreadToCpu(int cpu);
+
+// Undo both for the calling thread: SCHED_OTHER, any CPU. For helper threads started
+// from a realtime thread, which would otherwise inherit its priority and core.
+bool resetThreadScheduling();
+
+// Lock all current and future pages into RAM so the output path never takes a page fault
+bool lockProcessMemory();
@@ -0,0 +1,44 @@
+#include "RenderTarget.h"
+#include <iostream>
+
+BLContext* RenderTarget::begin() {
+    uint8_t* backData = dfb.getBackData();
+
+    Target* target = nullptr;
+    for (Target& candidate : targets) {
+        if (candidate.data == backData) {
+            target = &candidate;
+            break;
+        }
+    }
+
+    if (!target) {
+        for (Target& candidate : targets) {
+            if (candidate.data == nullptr) {
+                target = &candidate;
+                break;
+            }
+        }
+        if (!target) return nullptr; // Only ever two buffers
+
+        const int w = dfb.getWidth();
+        const int h = dfb.getHeight();
+        BLResult err = target->image.createFromData(w, h, BL_FORMAT_PRGB32, backData, w * 4, BL_DATA_ACCESS_RW);
+        if (err == BL_SUCCESS) {
+            err = target->context.begin(target->image);
+        }
+        if (err != BL_SUCCESS) {
+            std::cerr << "Failed to attach Blend2D context to framebuffer: " << err << std::endl;
+            return nullptr;
+        }
+        target->data = backData;
+    }
+
+    target->context.save();
+    return &target->context;
+}
+
+void RenderTarget::end(BLContext& ctx) {
+    ctx.restore();
+    ctx.flush(BL_CONTEXT_FLUSH_SYNC);
+}
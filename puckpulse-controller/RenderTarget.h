@@ -0,0 +1,29 @@
+#pragma once
+
+#include <blend2d.h>
+#include <array>
+#include "display/DoubleFramebuffer.h"
+
+// A Blend2D image and rendering context kept attached to each of the framebuffer's two
+// buffers, so a frame neither wraps the back buffer in a new BLImage nor creates (and
+// allocates) a new BLContext.
+class RenderTarget {
+public:
+    explicit RenderTarget(DoubleFramebuffer& dfb) : dfb(dfb) {}
+
+    // Context drawing into the current back buffer, in its default state; nullptr if the
+    // buffer could not be attached
+    BLContext* begin();
+    // Resets the state for the next frame and makes sure every pixel has been written
+    void end(BLContext& ctx);
+
+private:
+    struct Target {
+        uint8_t* data = nullptr;
+        BLImage image;
+        BLContext context;
+    };
+
+    DoubleFramebuffer& dfb;
+    std::array<Target, 2> targets;
+};
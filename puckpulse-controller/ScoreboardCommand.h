@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <variant>
+#include <vector>
+#include "ScoreboardState.h"
+
+// Scoreboard mutations as values, so any thread can hand them to the controller's owner
+// (ScoreboardController::submit()) instead of changing the state under the renderer.
+// Each maps to the controller method of the same name.
+namespace commands {
+
+struct SetHomeScore { int score; };
+struct SetAwayScore { int score; };
+struct SetTime { int minutes; int seconds; };
+struct SetHomeShots { int shots; };
+struct SetAwayShots { int shots; };
+struct SetHomePenalty { int index; int seconds; int playerNumber; };
+struct SetAwayPenalty { int index; int seconds; int playerNumber; };
+struct SetCurrentPeriod { int period; };
+struct SetHomeTeamName { std::string name; };
+struct SetAwayTeamName { std::string name; };
+struct SetClockMode { ClockMode mode; };
+struct ToggleClock {};
+struct AddHomeScore { int delta = 1; };
+struct AddAwayScore { int delta = 1; };
+struct AddHomeShots { int delta = 1; };
+struct AddAwayShots { int delta = 1; };
+struct AddHomePenalty { int seconds; int playerNumber; };
+struct AddAwayPenalty { int seconds; int playerNumber; };
+struct NextPeriod {};
+struct ResetGame {};
+struct TriggerGoalCelebration { std::string playerName; int playerNumber; std::vector<uint8_t> imageData; };
+
+}
+
+using ScoreboardCommand = std::variant<
+    commands::SetHomeScore, commands::SetAwayScore, commands::SetTime,
+    commands::SetHomeShots, commands::SetAwayShots,
+    commands::SetHomePenalty, commands::SetAwayPenalty, commands::SetCurrentPeriod,
+    commands::SetHomeTeamName, commands::SetAwayTeamName,
+    commands::SetClockMode, commands::ToggleClock,
+    commands::AddHomeScore, commands::AddAwayScore, commands::AddHomeShots, commands::AddAwayShots,
+    commands::AddHomePenalty, commands::AddAwayPenalty,
+    commands::NextPeriod, commands::ResetGame,
+    commands::TriggerGoalCelebration>;
@@ -3,20 +3,44 @@
 #include <ctime>
 #include <cmath>
 
+namespace {
+
+template <class... Handlers>
+struct Overloaded : Handlers... {
+    using Handlers::operator()...;
+};
+
+}
+
 ScoreboardController::ScoreboardController(StateChangeListener listener) : onStateChanged(listener) {
     // Initialize high-res timer from state
     gameTimeRemaining = state.timeMinutes * 60.0 + state.timeSeconds;
     lastUpdateTime = std::chrono::steady_clock::now();
+    publish();
 }
 
 const ScoreboardState& ScoreboardController::getState() const {
     return state;
 }
 
+void ScoreboardController::publish() {
+    auto next = std::make_shared<ScoreboardSnapshot>();
+    next->version = ++version;
+    next->state = state;
+    next->goalPlayerImage = goalPlayerImage;
+    next->goalPlayerImageGeneration = goalPlayerImageGeneration;
+    published.store(std::move(next), std::memory_order_release);
+}
+
 void ScoreboardController::notifyStateChanged() {
     dirty = true;
+    if (batching) {
+        notifyPending = true;
+        return;
+    }
+    publish();
     if (onStateChanged) {
-        onStateChanged(state);
+        onStateChanged(*snapshot());
     }
 }
 
@@ -27,12 +51,67 @@ void ScoreboardController::update() {
     update(diff.count());
 }
 
+bool ScoreboardController::submit(ScoreboardCommand command) {
+    if (commandQueue.push(std::move(command))) return true;
+    rejectedCommands.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void ScoreboardController::applyPendingCommands() {
+    while (std::optional<ScoreboardCommand> command = commandQueue.pop()) {
+        apply(std::move(*command));
+    }
+}
+
+void ScoreboardController::apply(ScoreboardCommand command) {
+    std::visit(Overloaded{
+        [this](const commands::SetHomeScore& c) { setHomeScore(c.score); },
+        [this](const commands::SetAwayScore& c) { setAwayScore(c.score); },
+        [this](const commands::SetTime& c) { setTime(c.minutes, c.seconds); },
+        [this](const commands::SetHomeShots& c) { setHomeShots(c.shots); },
+        [this](const commands::SetAwayShots& c) { setAwayShots(c.shots); },
+        [this](const commands::SetHomePenalty& c) { setHomePenalty(c.index, c.seconds, c.playerNumber); },
+        [this](const commands::SetAwayPenalty& c) { setAwayPenalty(c.index, c.seconds, c.playerNumber); },
+        [this](const commands::SetCurrentPeriod& c) { setCurrentPeriod(c.period); },
+        [this](const commands::SetHomeTeamName& c) { setHomeTeamName(c.name); },
+        [this](const commands::SetAwayTeamName& c) { setAwayTeamName(c.name); },
+        [this](const commands::SetClockMode& c) { setClockMode(c.mode); },
+        [this](const commands::ToggleClock&) { toggleClock(); },
+        [this](const commands::AddHomeScore& c) { addHomeScore(c.delta); },
+        [this](const commands::AddAwayScore& c) { addAwayScore(c.delta); },
+        [this](const commands::AddHomeShots& c) { addHomeShots(c.delta); },
+        [this](const commands::AddAwayShots& c) { addAwayShots(c.delta); },
+        [this](const commands::AddHomePenalty& c) { addHomePenalty(c.seconds, c.playerNumber); },
+        [this](const commands::AddAwayPenalty& c) { addAwayPenalty(c.seconds, c.playerNumber); },
+        [this](const commands::NextPeriod&) { nextPeriod(); },
+        [this](const commands::ResetGame&) { resetGame(); },
+        [this](commands::TriggerGoalCelebration& c) {
+            triggerGoalCelebration(c.playerName, c.playerNumber, std::move(c.imageData));
+        },
+    }, command);
+}
+
+// Everything a tick changes (queued commands, the clock, the end of a celebration) is
+// published and heard by listeners once, at the end, however many setters ran
 void ScoreboardController::update(double deltaTime) {
+    batching = true;
+    applyPendingCommands();
+    advance(deltaTime);
+    batching = false;
+
+    if (notifyPending) {
+        notifyPending = false;
+        notifyStateChanged();
+    }
+}
+
+void ScoreboardController::advance(double deltaTime) {
     if (state.goalEvent.active) {
         goalCelebrationTimeRemaining -= deltaTime;
         if (goalCelebrationTimeRemaining <= 0.0) {
             state.goalEvent.active = false;
-            goalPlayerImageData.clear();
+            goalPlayerImage.reset();
+            goalPlayerImageGeneration++;
             notifyStateChanged();
         }
     }
@@ -236,11 +315,12 @@ void ScoreboardController::setAwayTeamName(const std::string& name) {
     notifyStateChanged();
 }
 
-void ScoreboardController::triggerGoalCelebration(const std::string& playerName, int playerNumber, const std::vector<uint8_t>& imageData) {
+void ScoreboardController::triggerGoalCelebration(const std::string& playerName, int playerNumber, std::vector<uint8_t> imageData) {
     state.goalEvent.active = true;
     state.goalEvent.playerName = playerName;
     state.goalEvent.playerNumber = playerNumber;
-    goalPlayerImageData = imageData;
+    goalPlayerImage = imageData.empty() ? nullptr : std::make_shared<const std::vector<uint8_t>>(std::move(imageData));
+    goalPlayerImageGeneration++;
     goalCelebrationTimeRemaining = 5.0; // Show for 5 seconds
     notifyStateChanged();
 }
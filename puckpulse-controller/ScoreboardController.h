@@ -1,20 +1,49 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <chrono>
 #include <functional>
+#include <memory>
 #include "ScoreboardState.h"
+#include "ScoreboardSnapshot.h"
+#include "ScoreboardCommand.h"
+#include "MpscQueue.h"
 
+// The state has a single owner, the main loop: it calls update(), the setters and
+// getState(). Other threads (WebSocket connections) submit() commands instead, which the
+// owner applies at the start of its next update(), so the state never changes under the
+// renderer.
+//
+// Changes made during update() are coalesced: the tick publishes at most one new version
+// and calls the listener once. Setters called directly between ticks publish at once.
+//
+// Every change is published as a versioned ScoreboardSnapshot. snapshot() hands out the
+// latest one on any thread without waiting for the owner (RCU style: the owner swaps in a
+// new immutable copy, readers keep whichever copy they loaded).
 class ScoreboardController {
 public:
-    using StateChangeListener = std::function<void(const ScoreboardState&)>;
+    static constexpr size_t COMMAND_QUEUE_CAPACITY = 256;
+
+    using StateChangeListener = std::function<void(const ScoreboardSnapshot&)>;
     ScoreboardController(StateChangeListener listener = nullptr);
 
+    // Owner thread only
     const ScoreboardState& getState() const;
+    // Any thread: the most recently published state
+    [[nodiscard]] ScoreboardSnapshotPtr snapshot() const { return published.load(std::memory_order_acquire); }
 
     void update(); // Internal timing
     void update(double deltaTime); // External timing (optional/legacy)
 
+    // Any thread: queues a command for the next update(); false when the queue is full
+    bool submit(ScoreboardCommand command);
+    // Owner thread: applies a command now
+    void apply(ScoreboardCommand command);
+
+    [[nodiscard]] uint64_t pendingCommands() const { return commandQueue.size(); }
+    [[nodiscard]] uint64_t commandsRejected() const { return rejectedCommands.load(std::memory_order_relaxed); }
+
     // Scoreboard state management methods
     void setHomeScore(int score);
     void setAwayScore(int score);
@@ -37,21 +66,32 @@ public:
     void nextPeriod();
     void resetGame();
 
-    void triggerGoalCelebration(const std::string& playerName, int playerNumber, const std::vector<uint8_t>& imageData = {});
-    const std::vector<uint8_t>& getGoalPlayerImageData() const { return goalPlayerImageData; }
+    void triggerGoalCelebration(const std::string& playerName, int playerNumber, std::vector<uint8_t> imageData = {});
 
     [[nodiscard]] bool isDirty() const { return dirty; }
     void clearDirty() { dirty = false; }
 
 private:
     void notifyStateChanged();
+    void applyPendingCommands();
+    void advance(double deltaTime); // Clock, penalties and celebration timeout
+    void publish();
 
     ScoreboardState state;
     StateChangeListener onStateChanged;
     bool dirty = true;
 
+    MpscQueue<ScoreboardCommand, COMMAND_QUEUE_CAPACITY> commandQueue;
+    std::atomic<uint64_t> rejectedCommands{0};
+    bool batching = false;      // Inside update(); notify once at the end of the tick
+    bool notifyPending = false;
+
     double gameTimeRemaining = 0.0;
     double goalCelebrationTimeRemaining = 0.0;
-    std::vector<uint8_t> goalPlayerImageData;
+    std::shared_ptr<const std::vector<uint8_t>> goalPlayerImage;
+    uint64_t goalPlayerImageGeneration = 0;
+
+    uint64_t version = 0;
+    std::atomic<ScoreboardSnapshotPtr> published;
     std::chrono::steady_clock::time_point lastUpdateTime;
 };
@@ -1,10 +1,39 @@
 #include "ScoreboardRenderer.h"
 #include <iostream>
-#include <iomanip>
-#include <sstream>
+#include <charconv>
 
-ScoreboardRenderer::ScoreboardRenderer(DoubleFramebuffer& dfb, const ResourceLocator& resourceLocator, const ScoreboardState& state)
-    : dfb(dfb), _resourceLocator(resourceLocator), state(state) {
+namespace {
+
+// Fixed-capacity text for clock, score and penalty numbers, so formatting never allocates
+struct NumberText {
+    char data[16];
+    size_t size = 0;
+
+    NumberText& append(const int value, const int minDigits = 1) {
+        char digits[12];
+        auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+        const auto length = static_cast<size_t>(end - digits);
+        for (size_t i = length; i < static_cast<size_t>(minDigits) && size < sizeof(data); ++i) {
+            data[size++] = '0';
+        }
+        for (size_t i = 0; i < length && size < sizeof(data); ++i) {
+            data[size++] = digits[i];
+        }
+        return *this;
+    }
+
+    NumberText& append(const char c) {
+        if (size < sizeof(data)) data[size++] = c;
+        return *this;
+    }
+
+    [[nodiscard]] std::string_view view() const { return {data, size}; }
+};
+
+}
+
+ScoreboardRenderer::ScoreboardRenderer(DoubleFramebuffer& dfb, const ResourceLocator& resourceLocator)
+    : dfb(dfb), _resourceLocator(resourceLocator), target(dfb) {
     loadFont((_resourceLocator.getFontsDirPath() + "/digital-7 (mono).ttf").c_str());
 }
 
@@ -24,25 +53,28 @@ void ScoreboardRenderer::loadFont(const char* path) {
     goalFont.createFromFace(fontFace, 60.0f); // Large font for GOAL
 }
 
-void ScoreboardRenderer::render() const {
+double ScoreboardRenderer::textWidth(const BLFont& textFont, const std::string_view text) const {
+    BLTextMetrics tm{};
+    gb.setUtf8Text(text.data(), text.size());
+    textFont.getTextMetrics(gb, tm);
+    return tm.advance.x;
+}
+
+// Same shaping as BLContext::fillUtf8Text, but into the persistent glyph buffer instead of
+// a temporary one
+void ScoreboardRenderer::drawText(BLContext& ctx, const BLPoint& origin, const BLFont& textFont, const std::string_view text) const {
+    gb.setUtf8Text(text.data(), text.size());
+    textFont.shape(gb);
+    ctx.fillGlyphRun(origin, textFont, gb.glyphRun());
+}
+
+void ScoreboardRenderer::render(const ScoreboardSnapshot& snapshot) const {
     const int w = dfb.getWidth();
-    const int h = dfb.getHeight();
-
-    // Create a BLImage that references our pixel buffer.
-    BLImage image;
-    BLResult err = image.createFromData(
-        w, h, BL_FORMAT_PRGB32,
-        dfb.getBackData(),          // Raw pixel data
-        w * 4,                      // Stride in bytes
-        BL_DATA_ACCESS_RW           // Read/write access
-    );
-    if (err) {
-        std::cerr << "Failed to create Blend2D image from data: " << err << std::endl;
-        return;
-    }
+    const ScoreboardState& state = snapshot.state;
 
-    // Create a rendering context
-    BLContext ctx(image);
+    BLContext* context = target.begin();
+    if (!context) return;
+    BLContext& ctx = *context;
 
     // --- Drawing starts here ---
 
@@ -52,8 +84,6 @@ void ScoreboardRenderer::render() const {
     // Set the fill style for the text
     ctx.setFillStyle(colorWhite);
 
-    BLGlyphBuffer gb; // Initialize glyph buffer once
-
     // --- Metrics and Positioning ---
     BLFontMetrics teamNameFontMetrics = teamNameFont.metrics();
     double teamNameTextY = teamNameFontMetrics.capHeight + 4;
@@ -62,42 +92,23 @@ void ScoreboardRenderer::render() const {
     double clockTextY = mainFontMetrics.capHeight + 4;
 
     // Time Metrics (needed for centering team names relative to time border)
-    std::string minutes, seconds;
-    std::string colonStr = ":";
+    NumberText minutes, seconds;
+    constexpr std::string_view colonStr = ":";
     if (state.clockMode == ClockMode::Game && state.timeMinutes == 0 && state.timeSeconds < 60) {
         // Under 1 minute: Show SECONDS:TENTHS
-        std::stringstream ssMin;
-        ssMin << std::setfill('0') << std::setw(2) << state.timeSeconds;
-        minutes = ssMin.str();
-        
-        std::stringstream ssSec;
-        ssSec << state.timeTenths;
-        seconds = ssSec.str() + " "; // e.g. "9 " instead of "90"
+        minutes.append(state.timeSeconds, 2);
+        seconds.append(state.timeTenths).append(' '); // e.g. "9 " instead of "90"
     } else {
-        std::stringstream ssMin;
-        ssMin << std::setfill('0') << std::setw(2) << state.timeMinutes;
-        minutes = ssMin.str();
-        
-        std::stringstream ssSec;
-        ssSec << std::setfill('0') << std::setw(2) << state.timeSeconds;
-        seconds = ssSec.str();
+        minutes.append(state.timeMinutes, 2);
+        seconds.append(state.timeSeconds, 2);
     }
 
-    BLTextMetrics tmMin, tmColon, tmSec;
-    gb.setUtf8Text(minutes.c_str(), minutes.length());
-    font.getTextMetrics(gb, tmMin);
-    gb.clear();
-
-    gb.setUtf8Text(colonStr.c_str(), colonStr.length());
-    font.getTextMetrics(gb, tmColon);
-    gb.clear();
-
-    gb.setUtf8Text(seconds.c_str(), seconds.length());
-    font.getTextMetrics(gb, tmSec);
-    gb.clear();
+    const double minutesWidth = textWidth(font, minutes.view());
+    const double colonWidth = textWidth(font, colonStr);
+    const double secondsWidth = textWidth(font, seconds.view());
 
     double spacingAdjustment = 10.0;
-    double timeWidth = tmMin.advance.x + tmColon.advance.x + tmSec.advance.x - (2 * spacingAdjustment);
+    double timeWidth = minutesWidth + colonWidth + secondsWidth - (2 * spacingAdjustment);
     double startX = (w / 2.0) - (timeWidth / 2.0);
     int timePadding = 2;
     int timeRectX = (int)startX - timePadding;
@@ -106,40 +117,28 @@ void ScoreboardRenderer::render() const {
     ctx.setFillStyle(colorWhite);
 
     // Home Team Name (Centered in the left area)
-    gb.setUtf8Text(state.homeTeamName.c_str(), state.homeTeamName.length());
-    BLTextMetrics tmHomeName;
-    teamNameFont.getTextMetrics(gb, tmHomeName);
-    gb.clear();
-    double homeTeamNameWidth = tmHomeName.advance.x;
+    double homeTeamNameWidth = textWidth(teamNameFont, state.homeTeamName);
     double homeTeamNameX = (timeRectX / 2.0) - (homeTeamNameWidth / 2.0);
-    ctx.fillUtf8Text(BLPoint(homeTeamNameX, teamNameTextY), teamNameFont, state.homeTeamName.c_str());
+    drawText(ctx, BLPoint(homeTeamNameX, teamNameTextY), teamNameFont, state.homeTeamName);
 
     // Away Team Name (Centered in the right area)
-    gb.setUtf8Text(state.awayTeamName.c_str(), state.awayTeamName.length());
-    BLTextMetrics tmAwayName;
-    teamNameFont.getTextMetrics(gb, tmAwayName);
-    gb.clear();
-
-    double awayTeamNameWidth = tmAwayName.advance.x;
+    double awayTeamNameWidth = textWidth(teamNameFont, state.awayTeamName);
     int timeRectW = (int)timeWidth + (2 * timePadding);
     double awayTeamNameX = (timeRectX + timeRectW + w) / 2.0 - (awayTeamNameWidth / 2.0);
-    ctx.fillUtf8Text(BLPoint(awayTeamNameX, teamNameTextY), teamNameFont, state.awayTeamName.c_str());
+    drawText(ctx, BLPoint(awayTeamNameX, teamNameTextY), teamNameFont, state.awayTeamName);
 
     // Draw the time (centered)
     double currentX = startX;
 
     ctx.setFillStyle(colorOrange);
 
-    gb.setUtf8Text(minutes.c_str(), minutes.length());
-    ctx.fillUtf8Text(BLPoint(currentX, clockTextY), font, minutes.c_str());
-    currentX += tmMin.advance.x - spacingAdjustment;
+    drawText(ctx, BLPoint(currentX, clockTextY), font, minutes.view());
+    currentX += minutesWidth - spacingAdjustment;
 
-    gb.setUtf8Text(colonStr.c_str(), colonStr.length());
-    ctx.fillUtf8Text(BLPoint(currentX, clockTextY), font, colonStr.c_str());
-    currentX += tmColon.advance.x - spacingAdjustment;
+    drawText(ctx, BLPoint(currentX, clockTextY), font, colonStr);
+    currentX += colonWidth - spacingAdjustment;
 
-    gb.setUtf8Text(seconds.c_str(), seconds.length());
-    ctx.fillUtf8Text(BLPoint(currentX, clockTextY), font, seconds.c_str());
+    drawText(ctx, BLPoint(currentX, clockTextY), font, seconds.view());
 
     // Draw 1px white border around the time
     ctx.setStrokeStyle(colorWhite);
@@ -148,7 +147,6 @@ void ScoreboardRenderer::render() const {
     int timeRectH = (int)clockTextY + (3 * timePadding);
     ctx.strokeRect(timeRectX, timeRectY, timeRectW, timeRectH);
 
-    gb.clear();
     // Calculate Y position for the line below team names
     // --- Scores ---
     ctx.setFillStyle(colorRed);
@@ -156,60 +154,47 @@ void ScoreboardRenderer::render() const {
     // Draw the home score (Centered in the left area)
     BLFontMetrics fontMetrics = font.metrics();
     double mainTextY = 20 + fontMetrics.ascent ;
-    std::string homeScoreStr = std::to_string(state.homeScore);
+    NumberText homeScoreStr;
+    homeScoreStr.append(state.homeScore);
 
-    BLTextMetrics tmHomeScore{};
-    gb.setUtf8Text(homeScoreStr.c_str(), homeScoreStr.length());
-    font.getTextMetrics(gb, tmHomeScore);
-    gb.clear();
-    double homeScoreWidth = tmHomeScore.advance.x;
+    double homeScoreWidth = textWidth(font, homeScoreStr.view());
     double homeScoreX = (timeRectX / 2.0) - (homeScoreWidth / 2.0);
-    ctx.fillUtf8Text(BLPoint(homeScoreX, mainTextY), font, homeScoreStr.c_str());
+    drawText(ctx, BLPoint(homeScoreX, mainTextY), font, homeScoreStr.view());
 
     // Draw the away score (Centered in the right area)
-    std::string awayScoreStr = std::to_string(state.awayScore);
-    BLTextMetrics tmAwayScore{}; // For away score, using main font
-    gb.setUtf8Text(awayScoreStr.c_str(), awayScoreStr.length());
-    font.getTextMetrics(gb, tmAwayScore);
-    gb.clear();
-    double awayScoreWidth = tmAwayScore.advance.x; // Use advance.x for width
+    NumberText awayScoreStr;
+    awayScoreStr.append(state.awayScore);
+    double awayScoreWidth = textWidth(font, awayScoreStr.view()); // Use advance.x for width
     double awayScoreX = (timeRectX + timeRectW + w) / 2.0 - (awayScoreWidth / 2.0);
-    ctx.fillUtf8Text(BLPoint(awayScoreX , mainTextY), font, awayScoreStr.c_str());
+    drawText(ctx, BLPoint(awayScoreX , mainTextY), font, awayScoreStr.view());
 
     // Period label and number (centered under the time, at score height)
-    std::string periodLabel = "PERIOD";
-    std::string periodNum = std::to_string(state.currentPeriod);
-
-    BLTextMetrics tmPeriodLabel{}, tmPeriodNum{};
-    gb.setUtf8Text(periodLabel.c_str(), periodLabel.length());
-    periodFont.getTextMetrics(gb, tmPeriodLabel);
-    gb.clear();
+    constexpr std::string_view periodLabel = "PERIOD";
+    NumberText periodNum;
+    periodNum.append(state.currentPeriod);
 
-    gb.setUtf8Text(periodNum.c_str(), periodNum.length());
-    periodFont.getTextMetrics(gb, tmPeriodNum);
-    gb.clear();
+    const double periodLabelWidth = textWidth(periodFont, periodLabel);
+    const double periodNumWidth = textWidth(periodFont, periodNum.view());
 
-    double totalPeriodWidth = tmPeriodLabel.advance.x + tmPeriodNum.advance.x + 5;
+    double totalPeriodWidth = periodLabelWidth + periodNumWidth + 5;
     double periodX = timeRectX + (timeRectW / 2.0) - (totalPeriodWidth / 2.0);
 
     ctx.setFillStyle(colorWhite);
-    ctx.fillUtf8Text(BLPoint(periodX, mainTextY), periodFont, periodLabel.c_str());
+    drawText(ctx, BLPoint(periodX, mainTextY), periodFont, periodLabel);
     
     // Underline "PERIOD" (part of the label)
     ctx.setStrokeStyle(colorWhite);
     ctx.setStrokeWidth(1.0);
-    ctx.strokeLine(periodX, mainTextY + 2, periodX + tmPeriodLabel.advance.x, mainTextY + 2);
+    ctx.strokeLine(periodX, mainTextY + 2, periodX + periodLabelWidth, mainTextY + 2);
 
     ctx.setFillStyle(colorRed);
-    ctx.fillUtf8Text(BLPoint(periodX + tmPeriodLabel.advance.x + 5, mainTextY), periodFont, periodNum.c_str());
+    drawText(ctx, BLPoint(periodX + periodLabelWidth + 5, mainTextY), periodFont, periodNum.view());
 
     // --- Penalties ---
     auto formatTime = [](const int totalSeconds) {
-        const int m = totalSeconds / 60;
-        const int s = totalSeconds % 60;
-        std::stringstream ss;
-        ss << m << ":" << std::setfill('0') << std::setw(2) << s;
-        return ss.str();
+        NumberText text;
+        text.append(totalSeconds / 60).append(':').append(totalSeconds % 60, 2);
+        return text;
     };
 
     BLFontMetrics labelFontMetrics = labelFont.metrics();
@@ -223,33 +208,27 @@ void ScoreboardRenderer::render() const {
 
     // Home Penalty Labels
     ctx.setFillStyle(colorWhite);
-    ctx.fillUtf8Text(BLPoint(plyrOffset, penaltyLabelY), labelFont, "PLYR");
+    drawText(ctx, BLPoint(plyrOffset, penaltyLabelY), labelFont, "PLYR");
     
-    BLTextMetrics tmPlyrLabel;
-    gb.setUtf8Text("PLYR", 4);
-    labelFont.getTextMetrics(gb, tmPlyrLabel);
-    gb.clear();
+    const double plyrLabelWidth = textWidth(labelFont, "PLYR");
     ctx.setStrokeStyle(colorWhite);
     ctx.setStrokeWidth(1.0);
-    ctx.strokeLine(plyrOffset, penaltyLabelY + 2, plyrOffset + tmPlyrLabel.advance.x, penaltyLabelY + 2);
+    ctx.strokeLine(plyrOffset, penaltyLabelY + 2, plyrOffset + plyrLabelWidth, penaltyLabelY + 2);
 
-    ctx.fillUtf8Text(BLPoint(timeOffset, penaltyLabelY), labelFont, "PENALTY");
-    BLTextMetrics tmPenaltyLabel;
-    gb.setUtf8Text("PENALTY", 7);
-    labelFont.getTextMetrics(gb, tmPenaltyLabel);
-    gb.clear();
-    ctx.strokeLine(timeOffset, penaltyLabelY + 2, timeOffset + tmPenaltyLabel.advance.x, penaltyLabelY + 2);
+    drawText(ctx, BLPoint(timeOffset, penaltyLabelY), labelFont, "PENALTY");
+    const double penaltyLabelWidth = textWidth(labelFont, "PENALTY");
+    ctx.strokeLine(timeOffset, penaltyLabelY + 2, timeOffset + penaltyLabelWidth, penaltyLabelY + 2);
 
     // Away Penalty Labels
-    double awayPenaltyX = w - tmPenaltyLabel.advance.x - 5.0;
+    double awayPenaltyX = w - penaltyLabelWidth - 5.0;
     double awayPlyrX = awayPenaltyX - 50.0;
     double awayTimeX = awayPenaltyX;
 
-    ctx.fillUtf8Text(BLPoint(awayPlyrX, penaltyLabelY), labelFont, "PLYR");
-    ctx.strokeLine(awayPlyrX, penaltyLabelY + 2, awayPlyrX + tmPlyrLabel.advance.x, penaltyLabelY + 2);
+    drawText(ctx, BLPoint(awayPlyrX, penaltyLabelY), labelFont, "PLYR");
+    ctx.strokeLine(awayPlyrX, penaltyLabelY + 2, awayPlyrX + plyrLabelWidth, penaltyLabelY + 2);
 
-    ctx.fillUtf8Text(BLPoint(awayPenaltyX, penaltyLabelY), labelFont, "PENALTY");
-    ctx.strokeLine(awayPenaltyX, penaltyLabelY + 2, awayPenaltyX + tmPenaltyLabel.advance.x, penaltyLabelY + 2);
+    drawText(ctx, BLPoint(awayPenaltyX, penaltyLabelY), labelFont, "PENALTY");
+    ctx.strokeLine(awayPenaltyX, penaltyLabelY + 2, awayPenaltyX + penaltyLabelWidth, penaltyLabelY + 2);
 
     // Home Penalties
     int hRow = 0;
@@ -257,9 +236,9 @@ void ScoreboardRenderer::render() const {
         if (penalty.secondsRemaining > 0 || penalty.playerNumber > 0) {
             double yPos = (hRow == 0) ? penaltyRow1Y : penaltyRow2Y;
             ctx.setFillStyle(colorOrange);
-            ctx.fillUtf8Text(BLPoint(plyrOffset + 5, yPos), penaltyFont, std::to_string(penalty.playerNumber).c_str());
+            drawText(ctx, BLPoint(plyrOffset + 5, yPos), penaltyFont, NumberText().append(penalty.playerNumber).view());
             ctx.setFillStyle(colorRed);
-            ctx.fillUtf8Text(BLPoint(timeOffset +5, yPos), penaltyFont, formatTime(penalty.secondsRemaining).c_str());
+            drawText(ctx, BLPoint(timeOffset +5, yPos), penaltyFont, formatTime(penalty.secondsRemaining).view());
             hRow++;
         }
     }
@@ -270,9 +249,9 @@ void ScoreboardRenderer::render() const {
         if (penalty.secondsRemaining > 0 || penalty.playerNumber > 0) {
             double yPos = (aRow == 0) ? penaltyRow1Y : penaltyRow2Y;
             ctx.setFillStyle(colorOrange);
-            ctx.fillUtf8Text(BLPoint(awayPlyrX + 5, yPos), penaltyFont, std::to_string(penalty.playerNumber).c_str());
+            drawText(ctx, BLPoint(awayPlyrX + 5, yPos), penaltyFont, NumberText().append(penalty.playerNumber).view());
             ctx.setFillStyle(colorRed);
-            ctx.fillUtf8Text(BLPoint(awayTimeX + 5, yPos), penaltyFont, formatTime(penalty.secondsRemaining).c_str());
+            drawText(ctx, BLPoint(awayTimeX + 5, yPos), penaltyFont, formatTime(penalty.secondsRemaining).view());
             aRow++;
         }
     }
@@ -283,36 +262,28 @@ void ScoreboardRenderer::render() const {
     int sogValueY = sogLabelY - labelFontMetrics.ascent - 2; // Above the label
 
     // Centered "Shots on goal" label
-    std::string sogLabelStr = "Shots on goal";
-    BLTextMetrics tmSogLabel;
-    gb.setUtf8Text(sogLabelStr.c_str(), sogLabelStr.length());
-    labelFont.getTextMetrics(gb, tmSogLabel);
-    gb.clear();
-    int sogLabelX = w / 2.0 - tmSogLabel.advance.x / 2.0;
-    ctx.fillUtf8Text(BLPoint(sogLabelX, sogLabelY), labelFont, sogLabelStr.c_str());
+    constexpr std::string_view sogLabelStr = "Shots on goal";
+    const double sogLabelWidth = textWidth(labelFont, sogLabelStr);
+    int sogLabelX = w / 2.0 - sogLabelWidth / 2.0;
+    drawText(ctx, BLPoint(sogLabelX, sogLabelY), labelFont, sogLabelStr);
 
     // Underline "Shots on goal"
     ctx.setStrokeStyle(colorWhite);
     ctx.setStrokeWidth(1);
-    ctx.strokeLine(sogLabelX, sogLabelY + 2, sogLabelX + tmSogLabel.advance.x, sogLabelY + 2);
+    ctx.strokeLine(sogLabelX, sogLabelY + 2, sogLabelX + sogLabelWidth, sogLabelY + 2);
 
     ctx.setFillStyle(colorOrange);
 
     // Home SOG value (closer to center)
-    std::string homeShotsStr = std::to_string(state.homeShots);
-    BLTextMetrics tmHomeShots;
-    gb.setUtf8Text(homeShotsStr.c_str(), homeShotsStr.length());
-    shotsFont.getTextMetrics(gb, tmHomeShots);
-    gb.clear();
-    ctx.fillUtf8Text(BLPoint(w / 2.0 - 25.0 - tmHomeShots.advance.x, sogValueY), shotsFont, homeShotsStr.c_str());
+    NumberText homeShotsStr;
+    homeShotsStr.append(state.homeShots);
+    const double homeShotsWidth = textWidth(shotsFont, homeShotsStr.view());
+    drawText(ctx, BLPoint(w / 2.0 - 25.0 - homeShotsWidth, sogValueY), shotsFont, homeShotsStr.view());
 
     // Away SOG value (closer to center)
-    std::string awayShotsStr = std::to_string(state.awayShots);
-    BLTextMetrics tmAwayShots;
-    gb.setUtf8Text(awayShotsStr.c_str(), awayShotsStr.length());
-    shotsFont.getTextMetrics(gb, tmAwayShots);
-    gb.clear();
-    ctx.fillUtf8Text(BLPoint(w / 2.0 + 25.0, sogValueY), shotsFont, awayShotsStr.c_str());
-
-    ctx.end();
+    NumberText awayShotsStr;
+    awayShotsStr.append(state.awayShots);
+    drawText(ctx, BLPoint(w / 2.0 + 25.0, sogValueY), shotsFont, awayShotsStr.view());
+
+    target.end(ctx);
 }
@@ -5,17 +5,18 @@
 #include "ResourceLocator.h"
 #include "ScoreboardState.h"
 #include "IRenderer.h"
+#include "RenderTarget.h"
+#include <string_view>
 
 class ScoreboardRenderer : public IRenderer {
 public:
-    explicit ScoreboardRenderer(DoubleFramebuffer& dfb, const ResourceLocator& resourceLocator, const ScoreboardState& state);
+    explicit ScoreboardRenderer(DoubleFramebuffer& dfb, const ResourceLocator& resourceLocator);
 
-    void render() const override;
+    void render(const ScoreboardSnapshot& snapshot) const override;
 
 private:
     DoubleFramebuffer& dfb;
     const ResourceLocator& _resourceLocator;
-    const ScoreboardState& state;
 
     BLFontFace fontFace;
     BLFont font;
@@ -30,6 +31,13 @@ private:
     BLRgba32 colorOrange{255, 170, 51};
     BLRgba32 colorRed{255, 0, 0};
 
+    // Reused every frame so steady-state rendering doesn't allocate
+    mutable RenderTarget target;
+    mutable BLGlyphBuffer gb;
+
     void loadFont(const char* path);
     void renderGoalCelebration(BLContext& ctx, const ScoreboardState& state) const;
+
+    [[nodiscard]] double textWidth(const BLFont& textFont, std::string_view text) const;
+    void drawText(BLContext& ctx, const BLPoint& origin, const BLFont& textFont, std::string_view text) const;
 };
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "ScoreboardState.h"
+
+// An immutable copy of the scoreboard, published by the controller after every change (or
+// batch of queued commands). Readers on any thread hold one for as long as they need a
+// consistent view; it is freed when the last holder lets go.
+struct ScoreboardSnapshot {
+    uint64_t version = 0; // Increases by one per published change
+    ScoreboardState state;
+    // The goal photo is shared by every snapshot of the same goal rather than copied
+    std::shared_ptr<const std::vector<uint8_t>> goalPlayerImage;
+    // Changes whenever the goal photo is replaced, so renderers can cache the decoded image
+    uint64_t goalPlayerImageGeneration = 0;
+};
+
+using ScoreboardSnapshotPtr = std::shared_ptr<const ScoreboardSnapshot>;
@@ -6,6 +6,8 @@
 struct Penalty {
     int secondsRemaining = 0;
     int playerNumber = 0;
+
+    bool operator==(const Penalty&) const = default;
 };
 
 enum class ClockMode {
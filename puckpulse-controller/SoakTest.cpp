@@ -0,0 +1,266 @@
+#include "SoakTest.h"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <sys/resource.h>
+
+namespace {
+
+constexpr std::array<SoakTest::Pattern, 3> CYCLE = {
+    SoakTest::Pattern::Gradient, SoakTest::Pattern::Bars, SoakTest::Pattern::White,
+};
+
+constexpr int BAR_WIDTH = 16;
+constexpr int BAR_SPACING = 64;
+constexpr int BAR_SPEED = 2; // Pixels per frame
+
+// PRGB32 as the framebuffer stores it: 0xAARRGGBB in native byte order
+constexpr uint32_t pixel(const uint32_t r, const uint32_t g, const uint32_t b) {
+    return 0xFF000000u | (r << 16) | (g << 8) | b;
+}
+
+constexpr std::array<uint32_t, 4> BAR_COLORS = {
+    pixel(255, 0, 0), pixel(0, 255, 0), pixel(0, 0, 255), pixel(255, 255, 255),
+};
+
+uint64_t processCpuNs() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    auto ns = [](const timeval& tv) {
+        return static_cast<uint64_t>(tv.tv_sec) * 1'000'000'000ull + static_cast<uint64_t>(tv.tv_usec) * 1000ull;
+    };
+    return ns(usage.ru_utime) + ns(usage.ru_stime);
+}
+
+// SoC temperature in degrees C (Raspberry Pi and most other Linux boards), or < -273 when unknown
+double socTemperature() {
+    std::ifstream file("/sys/class/thermal/thermal_zone0/temp");
+    long milliDegrees = 0;
+    if (!(file >> milliDegrees)) return -1000.0;
+    return static_cast<double>(milliDegrees) / 1000.0;
+}
+
+std::string formatElapsed(const std::chrono::steady_clock::duration elapsed) {
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(elapsed).count();
+    std::ostringstream out;
+    out << std::setfill('0') << std::setw(2) << seconds / 3600 << ":"
+        << std::setw(2) << (seconds / 60) % 60 << ":" << std::setw(2) << seconds % 60;
+    return out.str();
+}
+
+double ms(const uint64_t ns) {
+    return static_cast<double>(ns) / 1e6;
+}
+
+}
+
+SoakTest::SoakTest(DoubleFramebuffer& dfb, const std::vector<IDisplay*>& displays)
+    : dfb(dfb), displays(displays) {}
+
+bool SoakTest::parsePattern(const std::string& name, Pattern& pattern) {
+    for (const Pattern candidate : CYCLE) {
+        if (name == patternName(candidate)) {
+            pattern = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* SoakTest::patternName(const Pattern pattern) {
+    switch (pattern) {
+        case Pattern::Gradient: return "gradient";
+        case Pattern::Bars: return "bars";
+        case Pattern::White: return "white";
+    }
+    return "?";
+}
+
+// Every pattern except white changes every pixel row every frame, so delta-encoding
+// outputs can't skip work and dropped packets show up as visible tears
+void SoakTest::drawPattern(const Pattern pattern, const uint64_t frame) {
+    auto* pixels = reinterpret_cast<uint32_t*>(dfb.getBackData());
+    const int w = dfb.getWidth();
+    const int h = dfb.getHeight();
+    const auto t = static_cast<uint32_t>(frame);
+
+    switch (pattern) {
+        case Pattern::Gradient:
+            // Diagonal red/green/blue ramps scrolling at different speeds
+            for (int y = 0; y < h; ++y) {
+                uint32_t* row = pixels + static_cast<size_t>(y) * w;
+                const uint32_t g = (static_cast<uint32_t>(y * 256 / h) + 2 * t) & 0xFF;
+                for (int x = 0; x < w; ++x) {
+                    const uint32_t r = (static_cast<uint32_t>(x * 256 / w) + t) & 0xFF;
+                    const uint32_t b = (static_cast<uint32_t>(x + y) + 3 * t) & 0xFF;
+                    row[x] = pixel(r, g, b);
+                }
+            }
+            break;
+        case Pattern::Bars: {
+            // Vertical bars sweeping right in red, green, blue and white, and a white bar sweeping down
+            const int shift = static_cast<int>((frame * BAR_SPEED) % static_cast<uint64_t>(BAR_SPACING * BAR_COLORS.size()));
+            const int sweepRow = static_cast<int>(frame % static_cast<uint64_t>(h));
+            for (int y = 0; y < h; ++y) {
+                uint32_t* row = pixels + static_cast<size_t>(y) * w;
+                if (y >= sweepRow && y < sweepRow + 4) {
+                    std::fill_n(row, w, BAR_COLORS.back());
+                    continue;
+                }
+                for (int x = 0; x < w; ++x) {
+                    const int position = x - shift + BAR_SPACING * static_cast<int>(BAR_COLORS.size());
+                    row[x] = position % BAR_SPACING < BAR_WIDTH
+                        ? BAR_COLORS[static_cast<size_t>(position / BAR_SPACING) % BAR_COLORS.size()]
+                        : pixel(0, 0, 0);
+                }
+            }
+            break;
+        }
+        case Pattern::White:
+            // Every LED at full brightness: worst-case supply current and heat
+            std::fill_n(pixels, static_cast<size_t>(w) * h, pixel(255, 255, 255));
+            break;
+    }
+}
+
+SoakTest::Snapshot SoakTest::snapshot() const {
+    Snapshot s;
+    s.time = std::chrono::steady_clock::now();
+    s.frames = frames;
+    s.cpuNs = processCpuNs();
+    for (const IDisplay* display : displays) {
+        s.packets.push_back(display->packetsSent());
+        s.bytes.push_back(display->bytesSent());
+        s.dropped.push_back(display->packetsDropped());
+    }
+    return s;
+}
+
+void SoakTest::report(const char* label, const Snapshot& from, const Snapshot& to,
+                      const std::vector<std::unique_ptr<LatencyHistogram>>& transmitTimes) const {
+    const double seconds = std::chrono::duration<double>(to.time - from.time).count();
+    if (seconds <= 0.0) return;
+    const uint64_t frameCount = to.frames - from.frames;
+    const double cpuPercent = static_cast<double>(to.cpuNs - from.cpuNs) / 1e9 / seconds * 100.0;
+
+    const auto flags = std::cout.flags();
+    std::cout << std::fixed << std::setprecision(1)
+              << label << "  " << static_cast<double>(frameCount) / seconds << " fps  cpu " << cpuPercent << "%";
+    if (const double temperature = socTemperature(); temperature > -273.0) {
+        std::cout << "  " << temperature << "C";
+    }
+    std::cout << std::endl;
+
+    for (size_t i = 0; i < displays.size(); ++i) {
+        const LatencyHistogram& tx = *transmitTimes[i];
+        const uint64_t packets = to.packets[i] - from.packets[i];
+        const uint64_t dropped = to.dropped[i] - from.dropped[i];
+        std::cout << "    " << std::left << std::setw(12) << displays[i]->name() << std::right
+                  << std::setprecision(2)
+                  << "tx mean " << (tx.count() > 0 ? ms(tx.sumNs() / tx.count()) : 0.0)
+                  << " p99 " << ms(tx.percentileNs(0.99)) << " max " << ms(tx.maxNs()) << " ms  "
+                  << std::setprecision(1)
+                  << (frameCount > 0 ? static_cast<double>(packets) / static_cast<double>(frameCount) : 0.0) << " pkt/frame  "
+                  << static_cast<double>(to.bytes[i] - from.bytes[i]) / seconds / 1e6 << " MB/s  "
+                  << dropped << " dropped";
+        if (packets + dropped > 0) {
+            std::cout << " (" << std::setprecision(3)
+                      << static_cast<double>(dropped) * 100.0 / static_cast<double>(packets + dropped) << "%)";
+        }
+        std::cout << std::endl;
+    }
+    std::cout.flags(flags);
+}
+
+int SoakTest::run(const SoakOptions& options, const std::atomic<bool>& running) {
+    if (displays.empty()) {
+        std::cerr << "Soak test needs at least one display (SFML, ColorLight, DDP or frame ring)." << std::endl;
+        return 1;
+    }
+
+    const bool cycle = options.pattern == "cycle";
+    Pattern fixedPattern = Pattern::Gradient;
+    if (!cycle && !parsePattern(options.pattern, fixedPattern)) {
+        std::cerr << "Unknown soak pattern '" << options.pattern << "'. Use gradient, bars, white or cycle." << std::endl;
+        return 1;
+    }
+
+    std::cout << "Soak test on " << displays.size() << " display(s), pattern " << options.pattern << ", "
+              << (options.maxFps > 0 ? "capped at " + std::to_string(options.maxFps) + " fps" : "uncapped") << ", "
+              << (options.durationSeconds > 0 ? "for " + formatElapsed(std::chrono::seconds(options.durationSeconds))
+                                              : "until interrupted") << std::endl;
+
+    auto newHistograms = [this] {
+        std::vector<std::unique_ptr<LatencyHistogram>> histograms;
+        for (size_t i = 0; i < displays.size(); ++i) histograms.push_back(std::make_unique<LatencyHistogram>());
+        return histograms;
+    };
+    const auto runTransmitTimes = newHistograms();
+    auto intervalTransmitTimes = newHistograms();
+
+    const Snapshot start = snapshot();
+    Snapshot intervalStart = start;
+    auto nextReport = start.time + REPORT_INTERVAL;
+    const auto frameInterval = options.maxFps > 0
+        ? std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::seconds(1)) / options.maxFps
+        : std::chrono::steady_clock::duration::zero();
+    auto frameDeadline = start.time;
+    double slowestFps = -1.0;
+
+    while (running) {
+        const auto elapsed = std::chrono::steady_clock::now() - start.time;
+        if (options.durationSeconds > 0 && elapsed >= std::chrono::seconds(options.durationSeconds)) break;
+
+        const Pattern pattern = cycle
+            ? CYCLE[static_cast<size_t>(elapsed / PATTERN_PERIOD) % CYCLE.size()]
+            : fixedPattern;
+        drawPattern(pattern, frames);
+        dfb.swap();
+
+        for (size_t i = 0; i < displays.size(); ++i) {
+            const auto sendStart = std::chrono::steady_clock::now();
+            displays[i]->output();
+            const auto sendTime = std::chrono::steady_clock::now() - sendStart;
+            runTransmitTimes[i]->record(sendTime);
+            intervalTransmitTimes[i]->record(sendTime);
+        }
+        ++frames;
+
+        if (std::chrono::steady_clock::now() >= nextReport) {
+            const Snapshot now = snapshot();
+            const std::string label = "[" + formatElapsed(now.time - start.time) + "] " + patternName(pattern);
+            report(label.c_str(), intervalStart, now, intervalTransmitTimes);
+
+            const double fps = static_cast<double>(now.frames - intervalStart.frames)
+                / std::chrono::duration<double>(now.time - intervalStart.time).count();
+            slowestFps = slowestFps < 0.0 ? fps : std::min(slowestFps, fps);
+
+            intervalStart = now;
+            intervalTransmitTimes = newHistograms();
+            nextReport += REPORT_INTERVAL;
+        }
+
+        if (options.maxFps > 0) {
+            frameDeadline += frameInterval;
+            const auto now = std::chrono::steady_clock::now();
+            if (now - frameDeadline > frameInterval) frameDeadline = now; // Fell behind; don't burst to catch up
+            std::this_thread::sleep_until(frameDeadline);
+        }
+    }
+
+    const Snapshot end = snapshot();
+    std::cout << std::endl << "Soak test finished after " << formatElapsed(end.time - start.time)
+              << ", " << end.frames - start.frames << " frames" << std::endl;
+    report("Whole run", start, end, runTransmitTimes);
+    if (slowestFps >= 0.0) {
+        const auto flags = std::cout.flags();
+        std::cout << std::fixed << std::setprecision(1) << "Slowest " << REPORT_INTERVAL.count()
+                  << "s interval: " << slowestFps << " fps" << std::endl;
+        std::cout.flags(flags);
+    }
+    return 0;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "display/DoubleFramebuffer.h"
+#include "display/IDisplay.h"
+#include "Metrics.h"
+
+struct SoakOptions {
+    uint64_t durationSeconds = 0; // 0: until interrupted
+    std::string pattern = "cycle";
+    int maxFps = 0;               // 0: as fast as the displays go
+};
+
+// Panel and network stress test (--soak): drives the configured displays back to back with
+// generated test patterns, without the 10ms tick, and reports the sustained frame rate,
+// per-display transmit time, packets and drops, CPU use and SoC temperature every
+// REPORT_INTERVAL and for the whole run. Meant to run for hours when validating a new Pi,
+// NIC or receiver firmware; run puckpulse-ddp-receiver (or the receiving card's own
+// counters) on the far end to see packets lost on the wire.
+//
+// All displays share one loop, so the slowest output sets the frame rate; its transmit
+// time in the report shows which one it is.
+class SoakTest {
+public:
+    enum class Pattern { Gradient, Bars, White };
+
+    static constexpr auto REPORT_INTERVAL = std::chrono::seconds(10);
+    // With --soak-pattern cycle, each pattern is held this long; long enough for a full
+    // white power test to show supply sag or thermal throttling
+    static constexpr auto PATTERN_PERIOD = std::chrono::seconds(60);
+
+    SoakTest(DoubleFramebuffer& dfb, const std::vector<IDisplay*>& displays);
+
+    // Runs until the duration has passed or running is cleared; returns the exit code
+    int run(const SoakOptions& options, const std::atomic<bool>& running);
+
+    static bool parsePattern(const std::string& name, Pattern& pattern);
+    static const char* patternName(Pattern pattern);
+
+private:
+    // Running totals, compared between two points in time for a report
+    struct Snapshot {
+        std::chrono::steady_clock::time_point time;
+        uint64_t frames = 0;
+        uint64_t cpuNs = 0; // User + system time of the whole process
+        std::vector<uint64_t> packets;
+        std::vector<uint64_t> bytes;
+        std::vector<uint64_t> dropped;
+    };
+
+    DoubleFramebuffer& dfb;
+    const std::vector<IDisplay*>& displays;
+    uint64_t frames = 0;
+
+    void drawPattern(Pattern pattern, uint64_t frame);
+    [[nodiscard]] Snapshot snapshot() const;
+    void report(const char* label, const Snapshot& from, const Snapshot& to,
+                const std::vector<std::unique_ptr<LatencyHistogram>>& transmitTimes) const;
+};
@@ -1,7 +1,8 @@
 #include "TeamManager.h"
+#include "Tracer.h"
+#include "Log.h"
 #include <filesystem>
 #include <fstream>
-#include <iostream>
 
 namespace fs = std::filesystem;
 
@@ -15,7 +16,7 @@ void TeamManager::ensureDataDirectoryExists() {
         try {
             fs::create_directories(dataDir);
         } catch (const fs::filesystem_error& e) {
-            std::cerr << "Error creating data directory: " << e.what() << std::endl;
+            LOG_ERROR("teams", "Error creating data directory", "path", dataDir, "error", e.what());
         }
     }
     std::string imagesDir = getImagesDirPath();
@@ -23,7 +24,7 @@ void TeamManager::ensureDataDirectoryExists() {
         try {
             fs::create_directories(imagesDir);
         } catch (const fs::filesystem_error& e) {
-            std::cerr << "Error creating images directory: " << e.what() << std::endl;
+            LOG_ERROR("teams", "Error creating images directory", "path", imagesDir, "error", e.what());
         }
     }
 }
@@ -36,7 +37,12 @@ std::string TeamManager::getImagesDirPath() const {
     return (fs::path(dataDir) / "images").string();
 }
 
+std::string TeamManager::getUploadsDirPath() const {
+    return (fs::path(getImagesDirPath()) / ".uploads").string();
+}
+
 void TeamManager::loadTeams() {
+    TRACE_SCOPE("teams", "loadTeams");
     if (!fs::exists(dataDir)) return;
 
     for (const auto& entry : fs::directory_iterator(dataDir)) {
@@ -48,7 +54,7 @@ void TeamManager::loadTeams() {
                 Team team = j.get<Team>();
                 teams[team.name] = team;
             } catch (const std::exception& e) {
-                std::cerr << "Error loading team from " << entry.path() << ": " << e.what() << std::endl;
+                LOG_ERROR("teams", "Error loading team", "path", entry.path().string(), "error", e.what());
             }
         }
     }
@@ -58,12 +64,13 @@ void TeamManager::saveTeam(const std::string& teamName) {
     auto it = teams.find(teamName);
     if (it == teams.end()) return;
 
+    TRACE_SCOPE("teams", "saveTeam");
     try {
         std::ofstream file(getTeamFilePath(teamName));
         nlohmann::json j = it->second;
         file << j.dump(4);
     } catch (const std::exception& e) {
-        std::cerr << "Error saving team " << teamName << ": " << e.what() << std::endl;
+        LOG_ERROR("teams", "Error saving team", "team", teamName, "error", e.what());
     }
 }
 
@@ -108,15 +115,16 @@ bool TeamManager::hasPlayer(const std::string& teamName, int playerNumber) const
 }
 
 bool TeamManager::savePlayerImage(const std::string& teamName, int playerNumber, const std::vector<uint8_t>& imageData, const std::string& extension) {
+    TRACE_SCOPE("teams", "savePlayerImage");
     std::string fileName = teamName + "_" + std::to_string(playerNumber) + extension;
     fs::path imagePath = fs::path(getImagesDirPath()) / fileName;
 
-    std::cout << "[TeamManager] Saving image to: " << imagePath << " (Size: " << imageData.size() << " bytes)" << std::endl;
+    LOG_INFO("teams", "Saving player image", "path", imagePath.string(), "bytes", imageData.size());
 
     try {
         std::ofstream file(imagePath, std::ios::binary);
         if (!file) {
-            std::cerr << "[TeamManager] Failed to open file for writing: " << imagePath << std::endl;
+            LOG_ERROR("teams", "Failed to open player image for writing", "path", imagePath.string());
             return false;
         }
         file.write(reinterpret_cast<const char*>(imageData.data()), imageData.size());
@@ -130,14 +138,14 @@ bool TeamManager::savePlayerImage(const std::string& teamName, int playerNumber,
                 return true;
             }
         }
-        std::cerr << "[TeamManager] Player #" << playerNumber << " not found in team " << teamName << " after saving image." << std::endl;
+        LOG_WARN("teams", "Player not found after saving image", "team", teamName, "number", playerNumber);
     } catch (const std::exception& e) {
-        std::cerr << "[TeamManager] Error saving player image: " << e.what() << std::endl;
+        LOG_ERROR("teams", "Error saving player image", "team", teamName, "number", playerNumber, "error", e.what());
     }
     return false;
 }
 
-std::vector<uint8_t> TeamManager::getPlayerImage(const std::string& teamName, int playerNumber) const {
+fs::path TeamManager::getPlayerImagePath(const std::string& teamName, int playerNumber) const {
     auto it = teams.find(teamName);
     if (it == teams.end()) return {};
 
@@ -153,7 +161,41 @@ std::vector<uint8_t> TeamManager::getPlayerImage(const std::string& teamName, in
 
     fs::path fullPath = fs::path(getImagesDirPath()) / fileName;
     if (!fs::exists(fullPath)) return {};
+    return fullPath;
+}
+
+bool TeamManager::adoptPlayerImage(const std::string& teamName, int playerNumber, const fs::path& file, const std::string& extension) {
+    TRACE_SCOPE("teams", "adoptPlayerImage");
+    if (!hasPlayer(teamName, playerNumber)) {
+        LOG_WARN("teams", "Player not found for uploaded image", "team", teamName, "number", playerNumber);
+        return false;
+    }
+    std::string fileName = teamName + "_" + std::to_string(playerNumber) + extension;
+    fs::path imagePath = fs::path(getImagesDirPath()) / fileName;
+
+    try {
+        // A rename within the data directory, so readers see the old image or the new one
+        fs::rename(file, imagePath);
+    } catch (const fs::filesystem_error& e) {
+        LOG_ERROR("teams", "Error moving uploaded image", "from", file.string(), "to", imagePath.string(), "error", e.what());
+        return false;
+    }
+
+    for (auto& p : teams[teamName].players) {
+        if (p.number == playerNumber) {
+            p.imagePath = fileName;
+            break;
+        }
+    }
+    saveTeam(teamName);
+    return true;
+}
+
+std::vector<uint8_t> TeamManager::getPlayerImage(const std::string& teamName, int playerNumber) const {
+    fs::path fullPath = getPlayerImagePath(teamName, playerNumber);
+    if (fullPath.empty()) return {};
 
+    TRACE_SCOPE("teams", "readPlayerImage");
     try {
         std::ifstream file(fullPath, std::ios::binary | std::ios::ate);
         std::streamsize size = file.tellg();
@@ -164,7 +206,7 @@ std::vector<uint8_t> TeamManager::getPlayerImage(const std::string& teamName, in
             return buffer;
         }
     } catch (const std::exception& e) {
-        std::cerr << "Error reading player image: " << e.what() << std::endl;
+        LOG_ERROR("teams", "Error reading player image", "path", fullPath.string(), "error", e.what());
     }
     return {};
 }
@@ -188,11 +230,12 @@ const Team* TeamManager::getTeam(const std::string& teamName) const {
 void TeamManager::deleteTeam(const std::string& teamName) {
     auto it = teams.find(teamName);
     if (it != teams.end()) {
+        TRACE_SCOPE("teams", "deleteTeam");
         try {
             fs::remove(getTeamFilePath(teamName));
             teams.erase(it);
         } catch (const fs::filesystem_error& e) {
-            std::cerr << "Error deleting team file: " << e.what() << std::endl;
+            LOG_ERROR("teams", "Error deleting team file", "team", teamName, "error", e.what());
         }
     }
 }
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <filesystem>
 #include <nlohmann/json.hpp>
 
 struct Player {
@@ -33,6 +34,12 @@ public:
     
     bool savePlayerImage(const std::string& teamName, int playerNumber, const std::vector<uint8_t>& imageData, const std::string& extension);
     std::vector<uint8_t> getPlayerImage(const std::string& teamName, int playerNumber) const;
+    // Path of the player's image file, or empty if there is none
+    std::filesystem::path getPlayerImagePath(const std::string& teamName, int playerNumber) const;
+    // Moves a finished upload into the images directory as the player's image
+    bool adoptPlayerImage(const std::string& teamName, int playerNumber, const std::filesystem::path& file, const std::string& extension);
+    // Where chunked uploads keep their part files; on the same filesystem as the images
+    std::string getUploadsDirPath() const;
 
     std::vector<std::string> getTeamNames() const;
     const Team* getTeam(const std::string& teamName) const;
@@ -0,0 +1,236 @@
+#include "Tracer.h"
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+std::atomic<bool> Tracer::s_enabled{false};
+
+namespace {
+
+struct Event {
+    const char* category;
+    const char* name;
+    uint64_t startNs;
+    uint64_t durationNs;
+};
+
+// Relaxed atomics rather than plain fields, so a dump may read a slot while its owner
+// overwrites it; snapshot() detects and drops such slots.
+struct Slot {
+    std::atomic<const char*> category{nullptr};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> startNs{0};
+    std::atomic<uint64_t> durationNs{0};
+};
+
+struct ThreadRing {
+    std::array<Slot, Tracer::RING_CAPACITY> slots;
+    std::atomic<uint64_t> head{0}; // Events ever written; the next goes to slots[head % capacity]
+
+    // Guarded by the registry mutex
+    int tid = 0;
+    std::string threadName;
+    bool inUse = true;
+
+    // Copies the events still in the ring, oldest first. The owner keeps writing meanwhile;
+    // it publishes head before touching a slot (see Tracer::record), so once head has been
+    // re-read after the copy, every slot it may have started to overwrite is known.
+    [[nodiscard]] std::vector<Event> snapshot() const {
+        const uint64_t end = head.load(std::memory_order_acquire);
+        const uint64_t begin = end > Tracer::RING_CAPACITY ? end - Tracer::RING_CAPACITY : 0;
+
+        std::vector<Event> events;
+        events.reserve(end - begin);
+        for (uint64_t i = begin; i < end; ++i) {
+            const Slot& slot = slots[i % Tracer::RING_CAPACITY];
+            events.push_back({slot.category.load(std::memory_order_relaxed), slot.name.load(std::memory_order_relaxed),
+                              slot.startNs.load(std::memory_order_relaxed), slot.durationNs.load(std::memory_order_relaxed)});
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t after = head.load(std::memory_order_relaxed);
+        const uint64_t firstIntact = after >= Tracer::RING_CAPACITY ? after - Tracer::RING_CAPACITY + 1 : 0;
+        if (firstIntact > begin) {
+            events.erase(events.begin(), events.begin() + static_cast<std::ptrdiff_t>(std::min<uint64_t>(firstIntact - begin, events.size())));
+        }
+        return events;
+    }
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadRing>> rings;
+    std::string outputDir;
+    uint64_t originNs = 0;
+};
+
+// Never destroyed: detached threads may still trace while the process exits
+Registry& registry() {
+    static auto* instance = new Registry;
+    return *instance;
+}
+
+ThreadRing* acquireRing() {
+    Registry& reg = registry();
+    std::lock_guard lock(reg.mutex);
+
+    // Rings of exited threads are reused (losing their events), so short-lived threads
+    // such as per-connection WebSocket threads don't grow memory without bound
+    ThreadRing* ring = nullptr;
+    for (auto& candidate : reg.rings) {
+        if (!candidate->inUse) {
+            ring = candidate.get();
+            ring->head.store(0, std::memory_order_relaxed);
+            ring->inUse = true;
+            break;
+        }
+    }
+    if (!ring) {
+        reg.rings.push_back(std::make_unique<ThreadRing>());
+        ring = reg.rings.back().get();
+    }
+
+    ring->tid = static_cast<int>(syscall(SYS_gettid));
+    char name[16] = {};
+    pthread_getname_np(pthread_self(), name, sizeof(name));
+    ring->threadName = name;
+    return ring;
+}
+
+struct RingHandle {
+    ThreadRing* ring = nullptr;
+
+    ~RingHandle() {
+        if (!ring) return;
+        std::lock_guard lock(registry().mutex);
+        ring->inUse = false; // Its events stay dumpable until another thread takes the ring
+    }
+};
+
+thread_local RingHandle t_ring;
+
+ThreadRing* localRing() {
+    if (!t_ring.ring) t_ring.ring = acquireRing();
+    return t_ring.ring;
+}
+
+void writeEscaped(std::ostream& out, const char* text) {
+    for (; text && *text; ++text) {
+        const char c = *text;
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << ' ';
+        } else {
+            out << c;
+        }
+    }
+}
+
+}
+
+void Tracer::enable(const std::string& outputDir) {
+    Registry& reg = registry();
+    {
+        std::lock_guard lock(reg.mutex);
+        reg.outputDir = outputDir;
+        reg.originNs = nowNs();
+    }
+    s_enabled.store(true, std::memory_order_relaxed);
+}
+
+uint64_t Tracer::nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Tracer::record(const char* category, const char* name, const uint64_t startNs, const uint64_t endNs) {
+    ThreadRing* ring = localRing();
+    const uint64_t h = ring->head.load(std::memory_order_relaxed);
+    Slot& slot = ring->slots[h % RING_CAPACITY];
+
+    // Orders the previous head store before the slot stores, which snapshot() relies on
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.category.store(category, std::memory_order_relaxed);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.startNs.store(startNs, std::memory_order_relaxed);
+    slot.durationNs.store(endNs - startNs, std::memory_order_relaxed);
+    ring->head.store(h + 1, std::memory_order_release);
+}
+
+void Tracer::setThreadName(const char* name) {
+    ThreadRing* ring = localRing();
+    std::lock_guard lock(registry().mutex);
+    ring->threadName = name;
+}
+
+void Tracer::writeChromeJson(std::ostream& out) {
+    Registry& reg = registry();
+    std::lock_guard lock(reg.mutex);
+
+    const int pid = static_cast<int>(getpid());
+    const auto flags = out.flags();
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+    auto beginEvent = [&] {
+        out << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    for (const auto& ring : reg.rings) {
+        beginEvent();
+        out << R"({"ph":"M","name":"thread_name","pid":)" << pid << R"(,"tid":)" << ring->tid << R"(,"args":{"name":")";
+        writeEscaped(out, ring->threadName.c_str());
+        out << "\"}}";
+
+        for (const Event& event : ring->snapshot()) {
+            beginEvent();
+            out << R"({"ph":"X","cat":")";
+            writeEscaped(out, event.category);
+            out << R"(","name":")";
+            writeEscaped(out, event.name);
+            out << R"(","pid":)" << pid << R"(,"tid":)" << ring->tid
+                << R"(,"ts":)" << static_cast<double>(static_cast<int64_t>(event.startNs - reg.originNs)) / 1000.0
+                << R"(,"dur":)" << static_cast<double>(event.durationNs) / 1000.0 << "}";
+        }
+    }
+
+    out << "\n]}\n";
+    out.flags(flags);
+}
+
+std::string Tracer::dumpToFile() {
+    std::string dir;
+    {
+        std::lock_guard lock(registry().mutex);
+        dir = registry().outputDir;
+    }
+
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+
+    const auto unixMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    const fs::path path = fs::path(dir) / ("trace-" + std::to_string(unixMs) + ".json");
+
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Cannot write trace " << path << std::endl;
+        return "";
+    }
+    writeChromeJson(file);
+    return path.string();
+}
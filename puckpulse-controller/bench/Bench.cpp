@@ -0,0 +1,121 @@
+#include "Bench.h"
+#include "../AllocationTracker.h"
+#include <chrono>
+#include <algorithm>
+#include <iomanip>
+#include <cmath>
+
+namespace bench {
+
+static double percentile(const std::vector<double>& sorted, const double p) {
+    if (sorted.empty()) return 0;
+    const auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+Result measure(const std::string& suite, const std::string& name, const int iterations,
+               const std::function<void(int)>& fn) {
+    fn(0); // Warm-up: font caches, lazily created buffers
+
+    std::vector<double> samples;
+    samples.reserve(iterations);
+
+    const uint64_t allocationsBefore = AllocationTracker::totalCount();
+    const uint64_t bytesBefore = AllocationTracker::totalBytes();
+
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        fn(i);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        samples.push_back(static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    // samples was reserved up front, so the loop's own bookkeeping does not allocate
+    const uint64_t allocations = AllocationTracker::totalCount() - allocationsBefore;
+    const uint64_t bytes = AllocationTracker::totalBytes() - bytesBefore;
+
+    Result result;
+    result.suite = suite;
+    result.name = name;
+    result.iterations = iterations;
+    if (iterations > 0) {
+        double total = 0;
+        for (double s : samples) total += s;
+        result.meanNs = total / iterations;
+        result.allocsPerIteration = static_cast<double>(allocations) / iterations;
+        result.bytesPerIteration = static_cast<double>(bytes) / iterations;
+    }
+    std::sort(samples.begin(), samples.end());
+    result.p50Ns = percentile(samples, 0.50);
+    result.p99Ns = percentile(samples, 0.99);
+    result.maxNs = samples.empty() ? 0 : samples.back();
+    return result;
+}
+
+void printHeader(std::ostream& out) {
+    out << std::left << std::setw(10) << "suite" << std::setw(24) << "case"
+        << std::right << std::setw(12) << "mean ns" << std::setw(12) << "p50 ns"
+        << std::setw(12) << "p99 ns" << std::setw(12) << "max ns"
+        << std::setw(10) << "allocs" << std::setw(12) << "bytes" << std::setw(12) << "payload" << std::endl;
+}
+
+void printResult(std::ostream& out, const Result& result) {
+    out << std::left << std::setw(10) << result.suite << std::setw(24) << result.name
+        << std::right << std::fixed << std::setprecision(0)
+        << std::setw(12) << result.meanNs << std::setw(12) << result.p50Ns
+        << std::setw(12) << result.p99Ns << std::setw(12) << result.maxNs
+        << std::setprecision(1) << std::setw(10) << result.allocsPerIteration
+        << std::setprecision(0) << std::setw(12) << result.bytesPerIteration;
+    if (result.payloadBytes > 0) out << std::setw(12) << result.payloadBytes;
+    out << std::endl;
+}
+
+nlohmann::json toJson(const std::vector<Result>& results) {
+    nlohmann::json cases = nlohmann::json::array();
+    for (const auto& r : results) {
+        cases.push_back({
+            {"suite", r.suite},
+            {"name", r.name},
+            {"iterations", r.iterations},
+            {"meanNs", r.meanNs},
+            {"p50Ns", r.p50Ns},
+            {"p99Ns", r.p99Ns},
+            {"maxNs", r.maxNs},
+            {"allocsPerIteration", r.allocsPerIteration},
+            {"bytesPerIteration", r.bytesPerIteration},
+            {"payloadBytes", r.payloadBytes},
+        });
+    }
+
+    nlohmann::json report;
+    report["version"] = PUCKPULSE_VERSION;
+    report["timestamp"] = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    report["cases"] = cases;
+    return report;
+}
+
+void printComparison(std::ostream& out, const std::vector<Result>& results, const nlohmann::json& baseline) {
+    auto change = [](const double now, const double before) {
+        return before > 0 ? (now - before) / before * 100.0 : 0.0;
+    };
+
+    out << std::endl << "Compared with baseline " << baseline.value("version", "?") << ":" << std::endl;
+    out << std::left << std::setw(10) << "suite" << std::setw(24) << "case"
+        << std::right << std::setw(12) << "mean" << std::setw(12) << "p99" << std::setw(16) << "allocs" << std::endl;
+
+    for (const auto& r : results) {
+        for (const auto& base : baseline.value("cases", nlohmann::json::array())) {
+            if (base.value("suite", "") != r.suite || base.value("name", "") != r.name) continue;
+
+            out << std::left << std::setw(10) << r.suite << std::setw(24) << r.name
+                << std::right << std::fixed << std::setprecision(1) << std::showpos
+                << std::setw(11) << change(r.meanNs, base.value("meanNs", 0.0)) << "%"
+                << std::setw(11) << change(r.p99Ns, base.value("p99Ns", 0.0)) << "%"
+                << std::setw(16) << r.allocsPerIteration - base.value("allocsPerIteration", 0.0)
+                << std::noshowpos << std::endl;
+        }
+    }
+}
+
+}
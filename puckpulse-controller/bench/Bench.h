@@ -0,0 +1,74 @@
+#pragma once
+
+// Shared harness for the puckpulse-bench suites: times a case iteration by iteration and
+// counts heap allocations made while it runs, so results can be reported as mean/p50/p99
+// ns per iteration plus allocations per iteration.
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <ostream>
+#include <nlohmann/json.hpp>
+
+namespace bench {
+
+struct Result {
+    std::string suite;
+    std::string name;
+    int iterations = 0;
+    double meanNs = 0;
+    double p50Ns = 0;
+    double p99Ns = 0;
+    double maxNs = 0;
+    double allocsPerIteration = 0;
+    double bytesPerIteration = 0;
+    double payloadBytes = 0; // Size of the message a wire case produces or reads; 0 elsewhere
+};
+
+// Runs fn(i) once untimed as a warm-up, then `iterations` timed times. Allocations are
+// counted by AllocationTracker across all subsystems.
+Result measure(const std::string& suite, const std::string& name, int iterations,
+               const std::function<void(int)>& fn);
+
+void printHeader(std::ostream& out);
+void printResult(std::ostream& out, const Result& result);
+
+nlohmann::json toJson(const std::vector<Result>& results);
+
+// Prints the change of every case found in a previous --json report
+void printComparison(std::ostream& out, const std::vector<Result>& results, const nlohmann::json& baseline);
+
+// --- Suites ---
+
+std::vector<Result> runRenderSuite(int iterations);
+std::vector<Result> runTraceSuite(int iterations);
+std::vector<Result> runWireSuite(int iterations);
+std::vector<Result> runCommandSuite(int iterations);
+std::vector<Result> runBase64Suite(int iterations);
+
+// --- Allocation check ---
+
+// Renders every corpus scene `iterations` times after a warm-up and fails each scene whose
+// steady-state frames allocate at all. Returns the number of failures.
+int checkZeroAllocations(int iterations);
+
+// --- Base64 round trip ---
+
+// Checks every supported base64 kernel against the scalar one (and the original decoder's
+// handling of skipped characters) on every length up to 512 and `iterations` random
+// photo-sized inputs. Returns the number of failing cases.
+int checkBase64(int iterations);
+
+// --- Golden images ---
+
+// Renders the render corpus with a fixed clock and compares every frame byte for byte
+// with <dir>/<scene>.png, then checks each scene's p99 render time against its budget
+// (multiplied by budgetScale for slower machines). A frame that differs is written to
+// <outDir>/<scene>.actual.png. Returns the number of failures.
+int checkGoldenImages(const std::string& dir, const std::string& outDir, int iterations, double budgetScale);
+
+// Writes <dir>/<scene>.png for every scene; review the diff before committing
+int updateGoldenImages(const std::string& dir);
+
+}
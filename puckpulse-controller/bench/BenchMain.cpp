@@ -0,0 +1,147 @@
+// puckpulse-bench: offscreen performance suites with text and JSON reports.
+//
+//   puckpulse-bench [--suite <name|all>] [--iterations <n>] [--json <file>] [--baseline <file>]
+//   puckpulse-bench --check-golden <dir> [--golden-out <dir>] [--budget-scale <x>]
+//   puckpulse-bench --update-golden <dir>
+//   puckpulse-bench --check-zero-alloc
+//   puckpulse-bench --check-base64
+//
+// Save a --json report on one commit and pass it as --baseline on another to see the
+// change per case. --check-golden exits non-zero on any pixel difference or blown render
+// budget, --check-zero-alloc on any heap allocation in a steady-state frame and
+// --check-base64 on any base64 kernel that disagrees with the scalar one, so all three can
+// gate CI.
+
+#include "Bench.h"
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <string>
+
+using SuiteRunner = std::vector<bench::Result> (*)(int iterations);
+
+static const std::map<std::string, SuiteRunner>& suites() {
+    static const std::map<std::string, SuiteRunner> all = {
+        {"render", bench::runRenderSuite},
+        {"trace", bench::runTraceSuite},
+        {"wire", bench::runWireSuite},
+        {"commands", bench::runCommandSuite},
+        {"base64", bench::runBase64Suite},
+    };
+    return all;
+}
+
+static void printHelp(const char* appName) {
+    std::cout << "Usage: " << appName << " [OPTIONS]" << std::endl;
+    std::cout << "  --suite <name>         Suite to run: all";
+    for (const auto& [name, runner] : suites()) std::cout << ", " << name;
+    std::cout << " (default: all)" << std::endl;
+    std::cout << "  --iterations <n>       Timed iterations per case (default: 500)" << std::endl;
+    std::cout << "  --json <file>          Write a machine-readable report" << std::endl;
+    std::cout << "  --baseline <file>      Compare against an earlier --json report" << std::endl;
+    std::cout << "  --check-golden <dir>   Compare renders with golden PNGs and enforce render budgets" << std::endl;
+    std::cout << "  --golden-out <dir>     Where --check-golden writes frames that differ (default: .)" << std::endl;
+    std::cout << "  --budget-scale <x>     Multiply render budgets (e.g. 3 on a Raspberry Pi; default: 1)" << std::endl;
+    std::cout << "  --update-golden <dir>  Re-render the golden PNGs" << std::endl;
+    std::cout << "  --check-zero-alloc     Fail if rendering any scene allocates after warm-up" << std::endl;
+    std::cout << "  --check-base64         Fail if any base64 kernel disagrees with the scalar one" << std::endl;
+    std::cout << "  -h, --help             Show this help message" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::string suiteName = "all";
+    int iterations = 500;
+    std::string jsonPath;
+    std::string baselinePath;
+    std::string goldenDir;
+    std::string goldenOutDir = ".";
+    bool updateGolden = false;
+    double budgetScale = 1.0;
+    bool checkZeroAlloc = false;
+    bool checkBase64 = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--suite" && hasValue) {
+            suiteName = argv[++i];
+        } else if (arg == "--iterations" && hasValue) {
+            iterations = std::stoi(argv[++i]);
+        } else if (arg == "--json" && hasValue) {
+            jsonPath = argv[++i];
+        } else if (arg == "--baseline" && hasValue) {
+            baselinePath = argv[++i];
+        } else if (arg == "--check-golden" && hasValue) {
+            goldenDir = argv[++i];
+        } else if (arg == "--update-golden" && hasValue) {
+            goldenDir = argv[++i];
+            updateGolden = true;
+        } else if (arg == "--golden-out" && hasValue) {
+            goldenOutDir = argv[++i];
+        } else if (arg == "--check-zero-alloc") {
+            checkZeroAlloc = true;
+        } else if (arg == "--check-base64") {
+            checkBase64 = true;
+        } else if (arg == "--budget-scale" && hasValue) {
+            budgetScale = std::stod(argv[++i]);
+        } else {
+            printHelp(argv[0]);
+            return arg == "-h" || arg == "--help" ? 0 : 1;
+        }
+    }
+
+    if (!goldenDir.empty()) {
+        const int failures = updateGolden
+            ? bench::updateGoldenImages(goldenDir)
+            : bench::checkGoldenImages(goldenDir, goldenOutDir, iterations, budgetScale);
+        return failures == 0 ? 0 : 1;
+    }
+
+    if (checkZeroAlloc) {
+        return bench::checkZeroAllocations(iterations) == 0 ? 0 : 1;
+    }
+
+    if (checkBase64) {
+        return bench::checkBase64(iterations) == 0 ? 0 : 1;
+    }
+
+    if (suiteName != "all" && !suites().contains(suiteName)) {
+        std::cerr << "Unknown suite: " << suiteName << std::endl;
+        printHelp(argv[0]);
+        return 1;
+    }
+
+    std::vector<bench::Result> results;
+    for (const auto& [name, runner] : suites()) {
+        if (suiteName != "all" && suiteName != name) continue;
+        auto suiteResults = runner(iterations);
+        results.insert(results.end(), suiteResults.begin(), suiteResults.end());
+    }
+
+    std::cout << std::endl;
+    bench::printHeader(std::cout);
+    for (const auto& result : results) {
+        bench::printResult(std::cout, result);
+    }
+
+    if (!baselinePath.empty()) {
+        std::ifstream baselineFile(baselinePath);
+        if (!baselineFile) {
+            std::cerr << "Cannot read baseline " << baselinePath << std::endl;
+            return 1;
+        }
+        bench::printComparison(std::cout, results, nlohmann::json::parse(baselineFile));
+    }
+
+    if (!jsonPath.empty()) {
+        std::ofstream jsonFile(jsonPath);
+        if (!jsonFile) {
+            std::cerr << "Cannot write " << jsonPath << std::endl;
+            return 1;
+        }
+        jsonFile << bench::toJson(results).dump(2) << std::endl;
+        std::cout << "Wrote " << jsonPath << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+// Commands suite: parsing and dispatching a recorded mix of WebSocket commands, the way
+// WebSocketManager did before the command table (command name copied out twice, metrics
+// found by string in a map, then a chain of string compares) and the way it does now (one
+// perfect-hash lookup into an array, then a typed ScoreboardCommand). Handlers themselves
+// are left out; both paths stop at the point where the command would be submitted.
+
+#include "Bench.h"
+#include "../network/CommandTable.h"
+#include <unordered_map>
+
+namespace bench {
+
+using json = nlohmann::json;
+
+// A stretch of a real game from the app: mostly clock and score buttons, a few penalties,
+// roster and image traffic from the team screen, and the odd stats poll
+static const char* const RECORDED_MIX[] = {
+    R"({"command":"toggleClock"})",
+    R"({"command":"addHomeShots","delta":1})",
+    R"({"command":"addAwayShots","delta":1})",
+    R"({"command":"addHomeShots","delta":1})",
+    R"({"command":"triggerGoal","isHome":true,"playerNumber":17})",
+    R"({"command":"toggleClock"})",
+    R"({"command":"addAwayPenalty","value":120,"player":4})",
+    R"({"command":"getImage","team":"RIVERSIDE","number":17})",
+    R"({"command":"toggleClock"})",
+    R"({"command":"addAwayShots","delta":1})",
+    R"({"command":"setTime","minutes":12,"seconds":30})",
+    R"({"command":"setHomeScore","value":2})",
+    R"({"command":"addOrUpdatePlayer","team":"NORTHGATE","name":"Sam Keller","number":21})",
+    R"({"command":"getTeams"})",
+    R"({"command":"setAwayPenalty","index":0,"value":0,"player":0})",
+    R"({"command":"getStats"})",
+    R"({"command":"nextPeriod"})",
+    R"({"command":"setClockMode","value":"Intermission"})",
+    R"({"command":"getState"})",
+    R"({"command":"setClockMode","value":"Game"})",
+};
+
+// Stands in for the per-command counter and latency the server updates
+struct BenchMetrics {
+    uint64_t count = 0;
+};
+
+// The command names in the order the old if/else chains tested them
+static const char* const LEGACY_ORDER[] = {
+    "hello", "getState", "getTeams", "uploadPlayerImage", "getImage", "triggerGoal", "subscribeFrames",
+    "unsubscribeFrames", "setDiagnosticOverlay", "getStats",
+    "setHomeScore", "setAwayScore", "addHomeScore", "addAwayScore", "addHomeShots", "addAwayShots",
+    "setHomeTeamName", "setAwayTeamName", "setHomePenalty", "setAwayPenalty", "addHomePenalty", "addAwayPenalty",
+    "toggleClock", "resetGame", "nextPeriod", "setTime", "setClockMode",
+    "addOrUpdatePlayer", "removePlayer", "deleteTeam",
+};
+
+// The old path; returns the position in the chain that matched, which is what the string
+// compares cost
+static size_t legacyDispatch(const json& j, std::unordered_map<std::string, BenchMetrics>& metrics) {
+    std::string cmd = j.value("command", "");
+    auto it = metrics.find(cmd);
+    (it != metrics.end() ? it->second : metrics.at("unknown")).count++;
+
+    // handleCommand() copied the name out again before its own chain
+    std::string again = j.value("command", "");
+    size_t position = 0;
+    for (const char* name : LEGACY_ORDER) {
+        if (again == name) break;
+        position++;
+    }
+    return position;
+}
+
+static size_t tableDispatch(const json& j, std::array<BenchMetrics, COMMAND_COUNT + 1>& metrics) {
+    const auto command = j.find("command");
+    const CommandId id = command != j.end() && command->is_string()
+        ? findCommand(command->get_ref<const std::string&>())
+        : CommandId::Unknown;
+    metrics[static_cast<size_t>(id)].count++;
+    if (isScoreboardCommand(id)) {
+        return parseScoreboardCommand(id, j).index();
+    }
+    return static_cast<size_t>(id);
+}
+
+std::vector<Result> runCommandSuite(const int iterations) {
+    std::vector<Result> results;
+    const size_t mixSize = std::size(RECORDED_MIX);
+
+    std::vector<json> parsed;
+    for (const char* message : RECORDED_MIX) parsed.push_back(json::parse(message));
+
+    std::unordered_map<std::string, BenchMetrics> legacyMetrics;
+    for (const char* name : LEGACY_ORDER) legacyMetrics[name] = {};
+    legacyMetrics["unknown"] = {};
+    std::array<BenchMetrics, COMMAND_COUNT + 1> tableMetrics{};
+
+    size_t sink = 0;
+
+    // Lookup and dispatch only, over the whole mix per iteration
+    results.push_back(measure("commands", "dispatch/legacy", iterations, [&](int) {
+        for (const json& j : parsed) sink += legacyDispatch(j, legacyMetrics);
+    }));
+    results.push_back(measure("commands", "dispatch/table", iterations, [&](int) {
+        for (const json& j : parsed) sink += tableDispatch(j, tableMetrics);
+    }));
+
+    // What a command costs from the received frame, parse included
+    results.push_back(measure("commands", "parse+dispatch/legacy", iterations, [&](const int i) {
+        sink += legacyDispatch(json::parse(RECORDED_MIX[i % mixSize]), legacyMetrics);
+    }));
+    results.push_back(measure("commands", "parse+dispatch/table", iterations, [&](const int i) {
+        sink += tableDispatch(json::parse(RECORDED_MIX[i % mixSize]), tableMetrics);
+    }));
+
+    // Names that aren't commands have to be rejected as cheaply as they're found
+    const json bogus = json::parse(R"({"command":"setHomeScor","value":1})");
+    results.push_back(measure("commands", "unknown/legacy", iterations, [&](int) {
+        sink += legacyDispatch(bogus, legacyMetrics);
+    }));
+    results.push_back(measure("commands", "unknown/table", iterations, [&](int) {
+        sink += tableDispatch(bogus, tableMetrics);
+    }));
+
+    if (sink == 0) results.clear(); // Keeps the work from being optimised away
+    return results;
+}
+
+}
@@ -0,0 +1,119 @@
+// Golden-image regression check for the renderers. Any pixel difference or blown render
+// budget is a failure, so caching/dirty-region style optimizations can land safely.
+
+#include "Bench.h"
+#include "RenderCorpus.h"
+#include <blend2d.h>
+#include <filesystem>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+
+namespace fs = std::filesystem;
+
+namespace bench {
+
+static BLImage frameImage(SceneRenderer& renderer) {
+    BLImage image(SceneRenderer::WIDTH, SceneRenderer::HEIGHT, BL_FORMAT_PRGB32);
+    BLImageData data;
+    image.makeMutable(&data);
+    for (int y = 0; y < SceneRenderer::HEIGHT; ++y) {
+        memcpy(static_cast<uint8_t*>(data.pixelData) + y * data.stride,
+               renderer.pixels() + y * SceneRenderer::WIDTH * 4, SceneRenderer::WIDTH * 4);
+    }
+    return image;
+}
+
+static bool writePng(const BLImage& image, const fs::path& path) {
+    BLImageCodec codec;
+    codec.findByName("PNG");
+    return image.writeToFile(path.string().c_str(), codec) == BL_SUCCESS;
+}
+
+// Returns the number of differing pixels (-1 if the golden image is missing or unreadable)
+static int compareWithGolden(const BLImage& actual, const fs::path& goldenPath) {
+    BLImage golden;
+    if (golden.readFromFile(goldenPath.string().c_str()) != BL_SUCCESS) return -1;
+    golden.convert(BL_FORMAT_PRGB32);
+    if (golden.width() != actual.width() || golden.height() != actual.height()) return -1;
+
+    BLImageData a, g;
+    actual.getData(&a);
+    golden.getData(&g);
+
+    int differing = 0;
+    for (int y = 0; y < actual.height(); ++y) {
+        const auto* rowA = static_cast<const uint32_t*>(a.pixelData) + y * (a.stride / 4);
+        const auto* rowG = static_cast<const uint32_t*>(g.pixelData) + y * (g.stride / 4);
+        for (int x = 0; x < actual.width(); ++x) {
+            if (rowA[x] != rowG[x]) differing++;
+        }
+    }
+    return differing;
+}
+
+int updateGoldenImages(const std::string& dir) {
+    fs::create_directories(dir);
+    SceneRenderer renderer(true);
+
+    int failures = 0;
+    for (const auto& scene : renderCorpus()) {
+        renderer.load(scene);
+        renderer.render();
+        const fs::path path = fs::path(dir) / (scene.name + ".png");
+        if (writePng(frameImage(renderer), path)) {
+            std::cout << "Wrote " << path.string() << std::endl;
+        } else {
+            std::cerr << "Failed to write " << path.string() << std::endl;
+            failures++;
+        }
+    }
+    return failures;
+}
+
+int checkGoldenImages(const std::string& dir, const std::string& outDir, const int iterations, const double budgetScale) {
+    SceneRenderer renderer(true);
+
+    int failures = 0;
+    for (const auto& scene : renderCorpus()) {
+        renderer.load(scene);
+        renderer.render();
+
+        const fs::path goldenPath = fs::path(dir) / (scene.name + ".png");
+        const BLImage actual = frameImage(renderer);
+        const int differing = compareWithGolden(actual, goldenPath);
+
+        const Result timing = measure("golden", scene.name, iterations, [&](int) {
+            renderer.render();
+        });
+        const double p99Ms = timing.p99Ns / 1e6;
+        const double budgetMs = scene.budgetMs * budgetScale;
+
+        std::cout << std::left << std::setw(24) << scene.name;
+        if (differing == 0) {
+            std::cout << std::setw(28) << "pixels OK";
+        } else {
+            // Keep the actual frame for inspection, outside the checked-in golden directory
+            std::error_code error;
+            fs::create_directories(outDir, error);
+            const fs::path actualPath = fs::path(outDir) / (scene.name + ".actual.png");
+            writePng(actual, actualPath);
+            std::string what = differing < 0 ? "MISSING/UNREADABLE golden" : std::to_string(differing) + " pixels differ";
+            std::cout << std::setw(28) << what;
+            failures++;
+        }
+
+        std::cout << std::fixed << std::setprecision(3) << "p99 " << p99Ms << " ms / " << budgetMs << " ms";
+        if (p99Ms > budgetMs) {
+            std::cout << "  OVER BUDGET";
+            failures++;
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << (failures == 0 ? "Golden check passed" : "Golden check FAILED") << std::endl;
+    return failures;
+}
+
+}
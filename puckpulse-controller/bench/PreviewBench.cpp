@@ -0,0 +1,98 @@
+// Compares the SFML preview paths: the original one-RectangleShape-per-pixel loop
+// against LedPreview (texture upload + single draw call). Both draw into an offscreen
+// RenderTexture of the preview window's size.
+//
+//   puckpulse-preview-bench [frames]
+
+#include "../display/LedPreview.h"
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <string>
+#include <functional>
+
+static constexpr unsigned int WIDTH = 384;
+static constexpr unsigned int HEIGHT = 160;
+static constexpr unsigned int PIXEL_SIZE = 4;
+static constexpr unsigned int PIXEL_GAP = 1;
+
+static void drawPerPixel(sf::RenderTarget& target, const uint8_t* pixels) {
+    sf::RectangleShape pixelShape(sf::Vector2f(static_cast<float>(PIXEL_SIZE), static_cast<float>(PIXEL_SIZE)));
+
+    for (unsigned int y = 0; y < HEIGHT; ++y) {
+        for (unsigned int x = 0; x < WIDTH; ++x) {
+            unsigned int index = (y * WIDTH + x) * 4;
+            pixelShape.setFillColor(sf::Color(pixels[index + 2], pixels[index + 1], pixels[index + 0], pixels[index + 3]));
+            pixelShape.setPosition(sf::Vector2f(static_cast<float>(x * (PIXEL_SIZE + PIXEL_GAP)),
+                                                static_cast<float>(y * (PIXEL_SIZE + PIXEL_GAP))));
+            target.draw(pixelShape);
+        }
+    }
+}
+
+static double timeFrames(const std::string& name, const int frames, sf::RenderTexture& target,
+                         const std::function<void(int)>& drawFrame) {
+    // Warm up so texture/buffer creation is not part of the measurement
+    drawFrame(0);
+    target.display();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+        target.clear();
+        drawFrame(i);
+        target.display();
+    }
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    double perFrame = elapsed / frames;
+    std::cout << std::left << std::setw(12) << name
+              << std::right << std::fixed << std::setprecision(3) << std::setw(10) << perFrame << " ms/frame"
+              << std::setw(10) << std::setprecision(1) << (1000.0 / perFrame) << " fps" << std::endl;
+    return perFrame;
+}
+
+int main(int argc, char* argv[]) {
+    const int frames = argc > 1 ? std::stoi(argv[1]) : 100;
+
+    // A moving gradient so every frame uploads different pixels
+    std::vector<uint8_t> frame(WIDTH * HEIGHT * 4);
+    auto fillFrame = [&frame](const int n) {
+        for (unsigned int y = 0; y < HEIGHT; ++y) {
+            for (unsigned int x = 0; x < WIDTH; ++x) {
+                uint8_t* p = &frame[(y * WIDTH + x) * 4];
+                p[0] = static_cast<uint8_t>(x + n);
+                p[1] = static_cast<uint8_t>(y * 2);
+                p[2] = static_cast<uint8_t>(255 - x);
+                p[3] = 255;
+            }
+        }
+    };
+
+    LedPreview preview(WIDTH, HEIGHT, PIXEL_SIZE, PIXEL_GAP);
+
+    sf::RenderTexture target;
+    if (!target.resize(preview.getSize())) {
+        std::cerr << "Failed to create offscreen render target" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Preview " << WIDTH << "x" << HEIGHT << " -> " << preview.getSize().x << "x" << preview.getSize().y
+              << ", " << frames << " frames" << std::endl;
+
+    double perPixel = timeFrames("per-pixel", frames, target, [&](const int n) {
+        fillFrame(n);
+        drawPerPixel(target, frame.data());
+    });
+
+    double fastPath = timeFrames("texture", frames, target, [&](const int n) {
+        fillFrame(n);
+        preview.update(frame.data());
+        preview.draw(target);
+    });
+
+    std::cout << "Speedup: " << std::setprecision(1) << (perPixel / fastPath) << "x" << std::endl;
+    return 0;
+}
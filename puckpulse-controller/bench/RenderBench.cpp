@@ -0,0 +1,22 @@
+// Render suite: draws the render corpus offscreen through the real ScoreboardRenderer and
+// GoalCelebrationRenderer (no display attached).
+
+#include "Bench.h"
+#include "RenderCorpus.h"
+
+namespace bench {
+
+std::vector<Result> runRenderSuite(const int iterations) {
+    std::vector<Result> results;
+    SceneRenderer renderer;
+
+    for (const auto& scene : renderCorpus()) {
+        renderer.load(scene);
+        results.push_back(measure("render", scene.name, iterations, [&](int) {
+            renderer.render();
+        }));
+    }
+    return results;
+}
+
+}
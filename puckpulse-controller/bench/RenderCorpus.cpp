@@ -0,0 +1,116 @@
+#include "RenderCorpus.h"
+#include <blend2d.h>
+#include <fstream>
+#include <iterator>
+#include <iostream>
+
+namespace bench {
+
+static ScoreboardState withPenalties(ScoreboardState state) {
+    state.homePenalties[0] = {120, 17};
+    state.homePenalties[1] = {45, 4};
+    state.awayPenalties[0] = {300, 88};
+    state.awayPenalties[1] = {9, 21};
+    return state;
+}
+
+static ScoreboardState goalBy(const std::string& playerName, const int playerNumber) {
+    ScoreboardState state;
+    state.goalEvent.active = true;
+    state.goalEvent.playerName = playerName;
+    state.goalEvent.playerNumber = playerNumber;
+    return state;
+}
+
+std::vector<RenderScene> renderCorpus() {
+    std::vector<RenderScene> corpus;
+
+    corpus.push_back({"default", ScoreboardState{}, false, 4.0});
+
+    ScoreboardState longNames;
+    longNames.homeTeamName = "MISSISSAUGA STEELHEADS";
+    longNames.awayTeamName = "SAULT STE. MARIE GREYHOUNDS";
+    corpus.push_back({"long-team-names", longNames, false, 4.0});
+
+    corpus.push_back({"penalties", withPenalties(ScoreboardState{}), false, 4.0});
+
+    ScoreboardState tenths;
+    tenths.timeMinutes = 0;
+    tenths.timeSeconds = 42;
+    tenths.timeTenths = 7;
+    tenths.isClockRunning = true;
+    corpus.push_back({"under-minute-tenths", tenths, false, 4.0});
+
+    ScoreboardState lateGame = withPenalties(ScoreboardState{});
+    lateGame.homeScore = 11;
+    lateGame.awayScore = 10;
+    lateGame.homeShots = 48;
+    lateGame.awayShots = 39;
+    lateGame.currentPeriod = 3;
+    lateGame.timeMinutes = 0;
+    lateGame.timeSeconds = 8;
+    lateGame.timeTenths = 3;
+    lateGame.isClockRunning = true;
+    lateGame.homeTeamName = "MISSISSAUGA STEELHEADS";
+    lateGame.awayTeamName = "SAULT STE. MARIE GREYHOUNDS";
+    corpus.push_back({"late-game-everything", lateGame, false, 4.0});
+
+    corpus.push_back({"goal-no-image", goalBy("JOHNSON", 17), false, 4.0});
+    corpus.push_back({"goal-with-image", goalBy("LUKER", 17), true, 8.0});
+
+    return corpus;
+}
+
+// The bundled sample player photo, or a generated PNG if the data dir does not have it
+static std::vector<uint8_t> loadPlayerImage(const ResourceLocator& resourceLocator) {
+    std::ifstream file(resourceLocator.getDataDirPath() + "/images/Luker_17.jpg", std::ios::binary);
+    if (file) {
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    std::cerr << "Sample player image not found; using a generated PNG" << std::endl;
+    BLImage image(300, 400, BL_FORMAT_PRGB32);
+    BLContext ctx(image);
+    BLGradient gradient(BLLinearGradientValues(0, 0, 300, 400));
+    gradient.addStop(0.0, BLRgba32(0xFF2060A0));
+    gradient.addStop(1.0, BLRgba32(0xFFE0C080));
+    ctx.fillAll(gradient);
+    ctx.end();
+
+    BLArray<uint8_t> encoded;
+    BLImageCodec codec;
+    codec.findByName("PNG");
+    image.writeToData(encoded, codec);
+    return {encoded.data(), encoded.data() + encoded.size()};
+}
+
+static GoalCelebrationRenderer::Clock clockFor(const bool fixedClock) {
+    if (!fixedClock) return std::chrono::steady_clock::now;
+    return [] { return std::chrono::steady_clock::time_point{}; };
+}
+
+SceneRenderer::SceneRenderer(const bool fixedClock)
+    : dfb(WIDTH, HEIGHT),
+      scoreboardRenderer(dfb, resourceLocator),
+      goalRenderer(dfb, resourceLocator, clockFor(fixedClock)) {
+    playerImage = std::make_shared<const std::vector<uint8_t>>(loadPlayerImage(resourceLocator));
+}
+
+// Publishes the scene the way the controller would: a new version, and a new photo
+// generation so the goal renderer decodes the photo once for this scene
+void SceneRenderer::load(const RenderScene& scene) {
+    snapshot.version++;
+    snapshot.state = scene.state;
+    snapshot.goalPlayerImage = scene.state.goalEvent.active && scene.withPlayerImage ? playerImage : nullptr;
+    snapshot.goalPlayerImageGeneration++;
+}
+
+void SceneRenderer::render() {
+    if (snapshot.state.goalEvent.active) {
+        goalRenderer.render(snapshot);
+    } else {
+        scoreboardRenderer.render(snapshot);
+    }
+}
+
+}
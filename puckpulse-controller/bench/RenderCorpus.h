@@ -0,0 +1,49 @@
+#pragma once
+
+// Representative board states shared by the render benchmark and the golden-image check,
+// and a small harness that draws them offscreen through the real renderers.
+
+#include "../display/DoubleFramebuffer.h"
+#include "../ScoreboardRenderer.h"
+#include "../GoalCelebrationRenderer.h"
+#include "../ScoreboardSnapshot.h"
+#include "../ResourceLocator.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace bench {
+
+struct RenderScene {
+    std::string name;
+    ScoreboardState state;     // goalEvent.active selects the goal celebration renderer
+    bool withPlayerImage = false;
+    double budgetMs = 0;       // p99 render-time budget enforced by --check-golden
+};
+
+std::vector<RenderScene> renderCorpus();
+
+class SceneRenderer {
+public:
+    static constexpr int WIDTH = 384;
+    static constexpr int HEIGHT = 160;
+
+    // With a fixed clock the goal blink is always in its "on" phase, so frames are repeatable
+    explicit SceneRenderer(bool fixedClock = false);
+
+    void load(const RenderScene& scene);
+    void render();
+
+    // The most recent frame (the back buffer is never swapped)
+    [[nodiscard]] const uint8_t* pixels() { return dfb.getBackData(); }
+
+private:
+    ResourceLocator resourceLocator;
+    DoubleFramebuffer dfb;
+    ScoreboardSnapshot snapshot;
+    ScoreboardRenderer scoreboardRenderer;
+    GoalCelebrationRenderer goalRenderer;
+    std::shared_ptr<const std::vector<uint8_t>> playerImage;
+};
+
+}
@@ -0,0 +1,25 @@
+// Trace suite: the cost of a TRACE_SCOPE with tracing off and on. The main loop records a
+// handful of scopes per 10ms tick, so "enabled" times that count must stay under 100us.
+
+#include "Bench.h"
+#include "../Tracer.h"
+#include <filesystem>
+
+namespace bench {
+
+std::vector<Result> runTraceSuite(const int iterations) {
+    std::vector<Result> results;
+
+    // Enabling is one-way, so the disabled case has to run first
+    results.push_back(measure("trace", "scope-disabled", iterations, [](int) {
+        TRACE_SCOPE("bench", "scope");
+    }));
+
+    Tracer::enable((std::filesystem::temp_directory_path() / "puckpulse-bench-traces").string());
+    results.push_back(measure("trace", "scope-enabled", iterations, [](int) {
+        TRACE_SCOPE("bench", "scope");
+    }));
+    return results;
+}
+
+}
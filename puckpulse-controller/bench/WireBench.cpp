@@ -0,0 +1,123 @@
+// Wire suite: building and encoding, then decoding, the WebSocket messages clients get most
+// (full state, clock-tick delta, team roster, player image) in JSON, CBOR and MessagePack.
+// The payload column is the encoded size; compare the three rows of a message to choose an
+// encoding, and the state and delta rows to see what delta broadcasts save.
+
+#include "Bench.h"
+#include "../network/WireProtocol.h"
+#include <random>
+
+namespace bench {
+
+using json = nlohmann::json;
+
+static ScoreboardState benchState() {
+    ScoreboardState state;
+    state.homeScore = 3;
+    state.awayScore = 2;
+    state.timeMinutes = 14;
+    state.timeSeconds = 27;
+    state.homeShots = 31;
+    state.awayShots = 24;
+    state.currentPeriod = 2;
+    state.homeTeamName = "RIVERSIDE";
+    state.awayTeamName = "NORTHGATE";
+    state.homePenalties[0] = {95, 17};
+    state.isClockRunning = true;
+    return state;
+}
+
+// Two full benches of players, half of them with photos
+static std::vector<Team> benchTeams() {
+    std::vector<Team> teams;
+    for (const char* name : {"RIVERSIDE", "NORTHGATE"}) {
+        Team team{name, {}};
+        for (int number = 1; number <= 22; ++number) {
+            team.players.push_back({"Player Number " + std::to_string(number), number,
+                                    number % 2 ? "images/" + team.name + "_" + std::to_string(number) + ".jpg" : ""});
+        }
+        teams.push_back(std::move(team));
+    }
+    return teams;
+}
+
+// The size of a typical phone photo after the app's resize; random bytes, like JPEG data,
+// don't compress
+static std::vector<uint8_t> benchImage() {
+    std::vector<uint8_t> image(60 * 1024);
+    std::mt19937 random(42);
+    for (uint8_t& byte : image) byte = static_cast<uint8_t>(random());
+    return image;
+}
+
+std::vector<Result> runWireSuite(const int iterations) {
+    std::vector<Result> results;
+    const Base64Coder base64Coder;
+
+    const ScoreboardState state = benchState();
+    ScoreboardState nextSecond = state;
+    nextSecond.timeSeconds--;
+    const std::vector<Team> teams = benchTeams();
+    const std::vector<uint8_t> image = benchImage();
+
+    // Each builder makes the message the way WebSocketManager does, so encode times
+    // include the per-encoding work (base64 only for JSON images)
+    const std::pair<const char*, std::function<json(WireEncoding)>> messages[] = {
+        {"state", [&](WireEncoding) {
+            json j = wire::stateToJson(state);
+            j["type"] = "state";
+            j["seq"] = 1234;
+            return j;
+        }},
+        {"delta", [&](WireEncoding) {
+            json j;
+            j["type"] = "stateDelta";
+            j["seq"] = 1235;
+            j["base"] = 1234;
+            j["changes"] = wire::stateChanges(state, nextSecond);
+            return j;
+        }},
+        {"teams", [&](WireEncoding) {
+            json j;
+            j["type"] = "teams";
+            j["teams"] = json::array();
+            for (const Team& team : teams) j["teams"].push_back(wire::teamToJson(team));
+            return j;
+        }},
+        {"image", [&](const WireEncoding encoding) {
+            json j;
+            j["type"] = "image";
+            j["team"] = "RIVERSIDE";
+            j["number"] = 17;
+            j["data"] = wire::bytesToJson(image, encoding, base64Coder);
+            return j;
+        }},
+    };
+
+    for (const auto& [message, build] : messages) {
+        for (const WireEncoding encoding : {WireEncoding::Json, WireEncoding::Cbor, WireEncoding::MessagePack}) {
+            const std::string prefix = std::string(message) + "/" + wire::encodingName(encoding);
+            const std::string payload = wire::encode(build(encoding), encoding);
+            const bool isImage = std::string_view(message) == "image";
+
+            std::string encoded;
+            Result encode = measure("wire", prefix + " encode", iterations, [&](int) {
+                encoded = wire::encode(build(encoding), encoding);
+            });
+            encode.payloadBytes = static_cast<double>(payload.size());
+            results.push_back(encode);
+
+            size_t decodedBytes = 0;
+            Result decode = measure("wire", prefix + " decode", iterations, [&](int) {
+                const json j = wire::decode(payload, encoding);
+                // Images are only useful as bytes, so that conversion is part of the cost
+                decodedBytes = isImage ? wire::bytesFromJson(j.at("data"), base64Coder).size() : j.size();
+            });
+            decode.payloadBytes = static_cast<double>(payload.size());
+            results.push_back(decode);
+        }
+    }
+    return results;
+}
+
+}
@@ -0,0 +1,60 @@
+// Steady-state allocation check for the renderers. Once both renderers have drawn a scene,
+// drawing it again must not touch the heap: no per-frame BLImage/BLContext, string
+// formatting or glyph buffer allocations, and no re-decoding of the goal photo.
+
+#include "Bench.h"
+#include "RenderCorpus.h"
+#include "../AllocationTracker.h"
+#include <array>
+#include <iostream>
+#include <iomanip>
+
+namespace bench {
+
+int checkZeroAllocations(const int iterations) {
+    // Fixed clock: a blink phase first seen after the warm-up must not count as steady state
+    SceneRenderer renderer(true);
+
+    int failures = 0;
+    for (const auto& scene : renderCorpus()) {
+        renderer.load(scene);
+        renderer.render();
+        renderer.render();
+
+        std::array<uint64_t, AllocationTracker::SUBSYSTEM_COUNT> before{};
+        for (size_t i = 0; i < before.size(); ++i) {
+            before[i] = AllocationTracker::count(static_cast<AllocationSubsystem>(i));
+        }
+
+        {
+            AllocationScope allocations(AllocationSubsystem::Render);
+            for (int i = 0; i < iterations; ++i) {
+                renderer.render();
+            }
+        }
+
+        uint64_t total = 0;
+        std::cout << std::left << std::setw(24) << scene.name;
+        for (size_t i = 0; i < before.size(); ++i) {
+            const auto subsystem = static_cast<AllocationSubsystem>(i);
+            const uint64_t allocations = AllocationTracker::count(subsystem) - before[i];
+            total += allocations;
+            if (allocations > 0) {
+                std::cout << AllocationTracker::name(subsystem) << " " << std::fixed << std::setprecision(2)
+                          << static_cast<double>(allocations) / iterations << " allocs/frame  ";
+            }
+        }
+        if (total == 0) {
+            std::cout << "0 allocs/frame";
+        } else {
+            std::cout << "ALLOCATES";
+            failures++;
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << (failures == 0 ? "Zero-allocation check passed" : "Zero-allocation check FAILED") << std::endl;
+    return failures;
+}
+
+}
@@ -1,5 +1,7 @@
 #include "ColorLightDisplay.h"
-#include "DoubleFramebuffer.h" // Needed for dfb
+#include "FrameSource.h"
+#include "PixelConversion.h"
+#include "../Tracer.h"
 #include <iostream>
 #include <utility>
 #include <vector>
@@ -26,8 +28,8 @@
 // We can fit about 497 pixels in one Ethernet frame (MTU 1500)
 #define CL_MAX_PIXL_PER_PACKET 497
 
-ColorLightDisplay::ColorLightDisplay(std::string  interface, DoubleFramebuffer& buffer)
-    : IDisplay(buffer), m_interface(std::move(interface)) {
+ColorLightDisplay::ColorLightDisplay(std::string  interface, const FrameSource& source)
+    : IDisplay(source), m_interface(std::move(interface)) {
     setupSocket();
 }
 
@@ -37,10 +39,11 @@ ColorLightDisplay::~ColorLightDisplay() {
 
 void ColorLightDisplay::output() {
     uint8_t packet[1500];
-    const int width = dfb.getWidth();
-    const int height = dfb.getHeight();
-    const uint8_t* framebuffer_data = dfb.getFrontData();
+    const int width = source.getWidth();
+    const int height = source.getHeight();
+    const uint8_t* framebuffer_data = source.getFrontData();
 
+    TRACE_SCOPE("colorlight", "send");
     sendBrightness(255);
 
     for (int rowNumber = 0; rowNumber < height; rowNumber++) {
@@ -67,17 +70,10 @@ void ColorLightDisplay::output() {
             packet[dataIndex++] = 0x08;
             packet[dataIndex++] = 0x88;
 
-            // Copy RGB data directly from our buffer into the packet starting at byte 20
-            // The data from the framebuffer is RGBA, but the ColorLight panel expects BGR.
-            // We need to swizzle the colors.
+            // Copy pixel data from our buffer into the packet starting at byte 20.
+            // The ColorLight panel expects BGR.
             const uint8_t* row_data_start = framebuffer_data + (rowNumber * width * 4) + (pixelsSent * 4);
-            uint8_t* packet_data_start = packet + dataIndex;
-
-            for (int i = 0; i < numPixels; ++i) {
-                packet_data_start[i * 3 + 0] = row_data_start[i * 4 + 0]; // Blue
-                packet_data_start[i * 3 + 1] = row_data_start[i * 4 + 1]; // Green
-                packet_data_start[i * 3 + 2] = row_data_start[i * 4 + 2]; // Red
-            }
+            packPixels(row_data_start, packet + dataIndex, numPixels, ChannelOrder::BGR);
 
             sendraw(packet, dataIndex + (numPixels * 3));
             pixelsSent += numPixels;
@@ -148,5 +144,9 @@ void ColorLightDisplay::sendraw(const uint8_t* data, const int len) {
     // Manually ensure the ethertype bytes are what the card expects
     // packet[12] = 0x55 (for data) or 0x01 (for sync)
     // packet[13] = sequence
-    sendto(m_sockfd, data, len, 0, reinterpret_cast<sockaddr *>(&m_socket_address), sizeof(m_socket_address));
+    if (sendto(m_sockfd, data, len, 0, reinterpret_cast<sockaddr *>(&m_socket_address), sizeof(m_socket_address)) >= 0) {
+        countSent(1, len);
+    } else {
+        countDropped(1);
+    }
 }
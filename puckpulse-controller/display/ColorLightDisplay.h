@@ -9,10 +9,11 @@
 
 class ColorLightDisplay : public IDisplay {
 public:
-    ColorLightDisplay(std::string  interface, DoubleFramebuffer& buffer);
+    ColorLightDisplay(std::string  interface, const FrameSource& source);
     ~ColorLightDisplay() override;
 
     void output() override;
+    [[nodiscard]] const char* name() const override { return "colorlight"; }
     void sendBrightness(uint8_t brightness);
 
 private:
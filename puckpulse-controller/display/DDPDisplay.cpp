@@ -0,0 +1,139 @@
+#include "DDPDisplay.h"
+#include "FrameSource.h"
+#include "PixelConversion.h"
+#include "../Tracer.h"
+#include "../Log.h"
+#include <iostream>
+#include <utility>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <netdb.h>
+#include <arpa/inet.h>
+
+// Constants based on the DDP specification (http://www.3waylabs.com/ddp/)
+#define DDP_HEADER_SIZE 10
+
+#define DDP_FLAGS_VER1 0x40
+#define DDP_FLAGS_PUSH 0x01
+
+#define DDP_TYPE_RGB24 0x0B
+#define DDP_ID_DISPLAY 0x01
+
+// 480 RGB pixels per packet keeps every datagram below a 1500 byte MTU
+#define DDP_MAX_DATA_PER_PACKET 1440
+
+DDPDisplay::DDPDisplay(std::string host, const uint16_t port, const FrameSource& source)
+    : IDisplay(source), m_host(std::move(host)), m_port(port) {
+    setupSocket();
+    preparePackets();
+}
+
+DDPDisplay::~DDPDisplay() {
+    if (m_sockfd >= 0) close(m_sockfd);
+}
+
+void DDPDisplay::preparePackets() {
+    const int frameBytes = source.getWidth() * source.getHeight() * 3;
+    const int packetCount = (frameBytes + DDP_MAX_DATA_PER_PACKET - 1) / DDP_MAX_DATA_PER_PACKET;
+
+    m_packets.assign(static_cast<size_t>(packetCount) * (DDP_HEADER_SIZE + DDP_MAX_DATA_PER_PACKET), 0);
+    m_iovecs.resize(packetCount);
+    m_messages.resize(packetCount);
+
+    for (int i = 0; i < packetCount; ++i) {
+        const uint32_t offset = static_cast<uint32_t>(i) * DDP_MAX_DATA_PER_PACKET;
+        const uint16_t length = static_cast<uint16_t>(std::min<int>(DDP_MAX_DATA_PER_PACKET, frameBytes - offset));
+        uint8_t* packet = m_packets.data() + static_cast<size_t>(i) * (DDP_HEADER_SIZE + DDP_MAX_DATA_PER_PACKET);
+
+        // The header only changes in the flags and sequence bytes, so fill in the rest once
+        packet[0] = DDP_FLAGS_VER1;
+        packet[2] = DDP_TYPE_RGB24;
+        packet[3] = DDP_ID_DISPLAY;
+        packet[4] = (offset >> 24) & 0xFF; // Data offset in bytes (big endian)
+        packet[5] = (offset >> 16) & 0xFF;
+        packet[6] = (offset >> 8) & 0xFF;
+        packet[7] = offset & 0xFF;
+        packet[8] = (length >> 8) & 0xFF;  // Data length (big endian)
+        packet[9] = length & 0xFF;
+
+        m_iovecs[i].iov_base = packet;
+        m_iovecs[i].iov_len = DDP_HEADER_SIZE + length;
+
+        memset(&m_messages[i], 0, sizeof(mmsghdr));
+        m_messages[i].msg_hdr.msg_name = &m_address;
+        m_messages[i].msg_hdr.msg_namelen = sizeof(m_address);
+        m_messages[i].msg_hdr.msg_iov = &m_iovecs[i];
+        m_messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    // Only the final packet of a frame asks the controller to display it
+    m_packets[(packetCount - 1) * (DDP_HEADER_SIZE + DDP_MAX_DATA_PER_PACKET)] |= DDP_FLAGS_PUSH;
+}
+
+void DDPDisplay::output() {
+    const uint8_t* framebuffer_data = source.getFrontData();
+    const int pixelsPerPacket = DDP_MAX_DATA_PER_PACKET / 3;
+    const int totalPixels = source.getWidth() * source.getHeight();
+
+    TRACE_SCOPE("ddp", "pack");
+    for (size_t i = 0; i < m_messages.size(); ++i) {
+        auto* packet = static_cast<uint8_t*>(m_iovecs[i].iov_base);
+        const int firstPixel = static_cast<int>(i) * pixelsPerPacket;
+        const int numPixels = std::min(pixelsPerPacket, totalPixels - firstPixel);
+
+        // Sequence numbers run 1-15; 0 means "not used" to the receiver
+        m_sequence = (m_sequence % 15) + 1;
+        packet[1] = m_sequence;
+
+        packPixels(framebuffer_data + firstPixel * 4, packet + DDP_HEADER_SIZE, numPixels, ChannelOrder::RGB);
+    }
+
+    TRACE_SCOPE("ddp", "sendmmsg");
+    size_t sent = 0;
+    while (sent < m_messages.size()) {
+        const int n = sendmmsg(m_sockfd, m_messages.data() + sent, m_messages.size() - sent, 0);
+        if (n <= 0) {
+            // Every frame fails while the controller is unplugged: counted, and logged
+            // through the rate limit rather than once per frame
+            const int error = errno;
+            countDropped(m_messages.size() - sent);
+            LOG_WARN("ddp", "DDP send failed", "error", strerror(error), "dropped", m_messages.size() - sent);
+            return;
+        }
+        uint64_t bytes = 0;
+        for (size_t i = sent; i < sent + n; ++i) {
+            bytes += m_iovecs[i].iov_len;
+        }
+        countSent(n, bytes);
+        sent += n;
+    }
+}
+
+void DDPDisplay::setupSocket() {
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+
+    addrinfo* result = nullptr;
+    const std::string port = std::to_string(m_port);
+    if (getaddrinfo(m_host.c_str(), port.c_str(), &hints, &result) != 0 || !result) {
+        std::cerr << "DDP host lookup failed: " << m_host << std::endl;
+        exit(1);
+    }
+    memcpy(&m_address, result->ai_addr, sizeof(m_address));
+    freeaddrinfo(result);
+
+    m_sockfd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (m_sockfd < 0) {
+        perror("DDP socket creation failed");
+        exit(1);
+    }
+
+    // A full frame is ~185 KB; give the kernel room to queue it without dropping packets
+    int sndbuf = 1024 * 1024;
+    setsockopt(m_sockfd, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
+
+    std::cout << "DDP output to " << inet_ntoa(m_address.sin_addr) << ":" << m_port << std::endl;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "IDisplay.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+// Distributed Display Protocol (DDP) output for ESP32/WLED and Falcon style pixel controllers.
+// The whole frame is streamed as large contiguous RGB chunks over UDP; the last packet of a
+// frame carries the PUSH flag so the controller latches all pixels at once.
+class DDPDisplay : public IDisplay {
+public:
+    static constexpr uint16_t DEFAULT_PORT = 4048;
+
+    DDPDisplay(std::string host, uint16_t port, const FrameSource& source);
+    ~DDPDisplay() override;
+
+    void output() override;
+    [[nodiscard]] const char* name() const override { return "ddp"; }
+
+private:
+    int m_sockfd = -1;
+    std::string m_host;
+    uint16_t m_port;
+    sockaddr_in m_address{};
+    uint8_t m_sequence = 0;
+
+    // Packets are built in place and handed to the kernel in a single sendmmsg() call.
+    std::vector<uint8_t> m_packets;
+    std::vector<iovec> m_iovecs;
+    std::vector<mmsghdr> m_messages;
+
+    void setupSocket();
+    void preparePackets();
+};
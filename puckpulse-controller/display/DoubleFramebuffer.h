@@ -3,8 +3,9 @@
 #include <vector>
 #include <cstdint>
 #include <mutex>
+#include "FrameSource.h"
 
-class DoubleFramebuffer {
+class DoubleFramebuffer : public FrameSource {
 private:
     int width, height;
     std::vector<uint8_t> bufferA;
@@ -24,8 +25,8 @@ public:
     // --- SYSTEM INTERFACE ---
     void swap();
     uint8_t* getBackData();
-    const uint8_t* getFrontData() const;
+    const uint8_t* getFrontData() const override;
 
-    [[nodiscard]] int getWidth() const { return width; }
-    [[nodiscard]] int getHeight() const { return height; }
+    [[nodiscard]] int getWidth() const override { return width; }
+    [[nodiscard]] int getHeight() const override { return height; }
 };
@@ -0,0 +1,106 @@
+#include "FramePlayer.h"
+#include "FrameRecording.h"
+#include <lz4.h>
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+
+namespace fs = std::filesystem;
+
+FramePlayer::FramePlayer(std::string directory) : directory(std::move(directory)) {}
+
+std::vector<std::string> FramePlayer::segmentsFor(const uint64_t fromMs, const uint64_t toMs) const {
+    std::vector<std::pair<uint64_t, std::string>> all;
+    try {
+        for (const auto& entry : fs::directory_iterator(directory)) {
+            if (!entry.is_regular_file() || entry.path().extension() != ".pprec") continue;
+            const std::string stem = entry.path().stem().string(); // frames-<unix ms>
+            auto dash = stem.find('-');
+            if (dash == std::string::npos) continue;
+            all.emplace_back(std::stoull(stem.substr(dash + 1)), entry.path().string());
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error listing recordings in " << directory << ": " << e.what() << std::endl;
+        return {};
+    }
+    std::sort(all.begin(), all.end());
+
+    // A segment covers [its start, next segment's start); keep the ones overlapping the window
+    std::vector<std::string> result;
+    for (size_t i = 0; i < all.size(); ++i) {
+        const uint64_t start = all[i].first;
+        const uint64_t end = (i + 1 < all.size()) ? all[i + 1].first : UINT64_MAX;
+        if (end >= fromMs && start <= toMs) {
+            result.push_back(all[i].second);
+        }
+    }
+    return result;
+}
+
+size_t FramePlayer::play(const uint64_t fromMs, const uint64_t toMs, const int width, const int height, const FrameCallback& onFrame) const {
+    const size_t rowBytes = static_cast<size_t>(width) * 4;
+    const size_t frameBytes = rowBytes * height;
+
+    std::vector<uint8_t> frame(frameBytes, 0);
+    std::vector<uint8_t> rowBitmap(FrameRecording::bitmapBytes(height));
+    std::vector<uint8_t> payload(frameBytes);
+    std::vector<char> compressed;
+    size_t delivered = 0;
+
+    for (const auto& path : segmentsFor(fromMs, toMs)) {
+        std::ifstream in(path, std::ios::binary);
+        FrameRecording::SegmentHeader segmentHeader{};
+        if (!in.read(reinterpret_cast<char*>(&segmentHeader), sizeof(segmentHeader)) ||
+            segmentHeader.magic != FrameRecording::SEGMENT_MAGIC ||
+            segmentHeader.version != FrameRecording::FORMAT_VERSION ||
+            segmentHeader.width != width || segmentHeader.height != height) {
+            std::cerr << "Skipping incompatible recording segment " << path << std::endl;
+            continue;
+        }
+
+        bool haveKeyframe = false;
+        FrameRecording::RecordHeader header{};
+        while (in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            compressed.resize(header.compressedSize);
+            if (!in.read(reinterpret_cast<char*>(rowBitmap.data()), static_cast<std::streamsize>(rowBitmap.size())) ||
+                !in.read(compressed.data(), header.compressedSize)) {
+                break; // Truncated tail (e.g. the controller was killed mid-write)
+            }
+            if (header.timestampMs > toMs) return delivered;
+
+            int payloadSize = 0;
+            if (header.compressedSize > 0) {
+                payloadSize = LZ4_decompress_safe(compressed.data(), reinterpret_cast<char*>(payload.data()),
+                                                  static_cast<int>(header.compressedSize), static_cast<int>(payload.size()));
+                if (payloadSize < 0) {
+                    std::cerr << "Corrupt frame record in " << path << std::endl;
+                    break;
+                }
+            }
+
+            haveKeyframe = haveKeyframe || header.keyframe;
+            if (!haveKeyframe) continue;
+
+            const uint8_t* rowData = payload.data();
+            for (int row = 0; row < height; ++row) {
+                if (!(rowBitmap[row / 8] & (1 << (row % 8)))) continue;
+                if (rowData + rowBytes > payload.data() + payloadSize) break;
+
+                uint8_t* out = frame.data() + row * rowBytes;
+                if (header.keyframe) {
+                    std::copy_n(rowData, rowBytes, out);
+                } else {
+                    for (size_t i = 0; i < rowBytes; ++i) out[i] ^= rowData[i];
+                }
+                rowData += rowBytes;
+            }
+
+            if (header.timestampMs >= fromMs) {
+                delivered++;
+                if (!onFrame(header.timestampMs, frame.data())) return delivered;
+            }
+        }
+    }
+    return delivered;
+}
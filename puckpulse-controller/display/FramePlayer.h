@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+// Decodes recordings written by FrameRecorder. Frames inside [fromMs, toMs] (Unix time in
+// milliseconds) are handed to the callback in order as full BGRA frames; frames before the
+// window are still decoded because deltas build on them.
+class FramePlayer {
+public:
+    using FrameCallback = std::function<bool(uint64_t timestampMs, const uint8_t* pixels)>;
+
+    explicit FramePlayer(std::string directory);
+
+    // Returns the number of frames delivered. The callback can return false to stop early.
+    size_t play(uint64_t fromMs, uint64_t toMs, int width, int height, const FrameCallback& onFrame) const;
+
+private:
+    std::string directory;
+
+    std::vector<std::string> segmentsFor(uint64_t fromMs, uint64_t toMs) const;
+};
@@ -0,0 +1,206 @@
+#include "FrameRecorder.h"
+#include "FrameRecording.h"
+#include "FrameSource.h"
+#include <lz4.h>
+#include <iostream>
+#include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace fs = std::filesystem;
+
+FrameRecorder::FrameRecorder(std::string directory, const FrameSource& source, const size_t segmentBytes, const size_t maxTotalBytes)
+    : IDisplay(source), directory(std::move(directory)), segmentBytes(segmentBytes), maxTotalBytes(maxTotalBytes) {
+    rowBytes = static_cast<size_t>(source.getWidth()) * 4;
+    frameBytes = rowBytes * source.getHeight();
+
+    try {
+        fs::create_directories(this->directory);
+    } catch (const fs::filesystem_error& e) {
+        std::cerr << "Error creating recording directory: " << e.what() << std::endl;
+    }
+
+    slots.resize(SLOT_COUNT);
+    for (auto& slot : slots) {
+        slot.pixels.resize(frameBytes);
+        freeSlots.push_back(&slot);
+    }
+
+    previous.resize(frameBytes);
+    rowBitmap.resize(FrameRecording::bitmapBytes(source.getHeight()));
+    payload.resize(frameBytes);
+    compressed.resize(LZ4_compressBound(static_cast<int>(frameBytes)));
+
+    writerThread = std::thread(&FrameRecorder::writerLoop, this);
+    std::cout << "Recording frames to " << this->directory << std::endl;
+}
+
+FrameRecorder::~FrameRecorder() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCondition.notify_one();
+    if (writerThread.joinable()) {
+        writerThread.join();
+    }
+    std::cout << "Frame recorder stopped (" << recorded << " frames recorded, " << dropped << " dropped)" << std::endl;
+}
+
+void FrameRecorder::output() {
+    PendingFrame* slot = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+    }
+    if (!slot) {
+        dropped++; // The writer is behind; never stall the render loop for it
+        return;
+    }
+
+    slot->timestampMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    memcpy(slot->pixels.data(), source.getFrontData(), frameBytes);
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        pending.push_back(slot);
+    }
+    queueCondition.notify_one();
+}
+
+void FrameRecorder::writerLoop() {
+    while (true) {
+        PendingFrame* frame = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (pending.empty()) break; // Stopping and fully drained
+            frame = pending.front();
+            pending.pop_front();
+        }
+
+        writeFrame(*frame);
+        recorded++;
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            freeSlots.push_back(frame);
+        }
+    }
+    segment.close();
+}
+
+void FrameRecorder::writeFrame(const PendingFrame& frame) {
+    if (!segment.is_open() || segmentWritten >= segmentBytes) {
+        openSegment(frame.timestampMs);
+    }
+    if (!segment) return;
+
+    const bool keyframe = framesSinceKeyframe == 0 || framesSinceKeyframe >= KEYFRAME_INTERVAL;
+    const int height = source.getHeight();
+
+    std::fill(rowBitmap.begin(), rowBitmap.end(), 0);
+    size_t payloadSize = 0;
+
+    for (int row = 0; row < height; ++row) {
+        const uint8_t* current = frame.pixels.data() + row * rowBytes;
+        uint8_t* last = previous.data() + row * rowBytes;
+
+        if (keyframe) {
+            memcpy(payload.data() + payloadSize, current, rowBytes);
+        } else {
+            if (memcmp(current, last, rowBytes) == 0) continue;
+            uint8_t* out = payload.data() + payloadSize;
+            for (size_t i = 0; i < rowBytes; ++i) {
+                out[i] = current[i] ^ last[i];
+            }
+        }
+        rowBitmap[row / 8] |= static_cast<uint8_t>(1 << (row % 8));
+        payloadSize += rowBytes;
+        memcpy(last, current, rowBytes);
+    }
+
+    int compressedSize = 0;
+    if (payloadSize > 0) {
+        compressedSize = LZ4_compress_default(reinterpret_cast<const char*>(payload.data()),
+                                              reinterpret_cast<char*>(compressed.data()),
+                                              static_cast<int>(payloadSize), static_cast<int>(compressed.size()));
+        if (compressedSize <= 0) {
+            std::cerr << "Frame recorder: LZ4 compression failed" << std::endl;
+            return;
+        }
+    }
+
+    FrameRecording::RecordHeader header{};
+    header.timestampMs = frame.timestampMs;
+    header.keyframe = keyframe ? 1 : 0;
+    header.compressedSize = static_cast<uint32_t>(compressedSize);
+
+    segment.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    segment.write(reinterpret_cast<const char*>(rowBitmap.data()), static_cast<std::streamsize>(rowBitmap.size()));
+    segment.write(reinterpret_cast<const char*>(compressed.data()), compressedSize);
+    segmentWritten += sizeof(header) + rowBitmap.size() + compressedSize;
+    countSent(1, sizeof(header) + rowBitmap.size() + compressedSize);
+
+    framesSinceKeyframe = keyframe ? 1 : framesSinceKeyframe + 1;
+}
+
+void FrameRecorder::openSegment(const uint64_t timestampMs) {
+    segment.close();
+
+    // Segment names must be unique and sort by start time
+    uint64_t nameMs = timestampMs;
+    fs::path path;
+    do {
+        path = fs::path(directory) / ("frames-" + std::to_string(nameMs++) + ".pprec");
+    } while (fs::exists(path));
+
+    segment.open(path, std::ios::binary | std::ios::trunc);
+    if (!segment) {
+        std::cerr << "Frame recorder: failed to open " << path << std::endl;
+        return;
+    }
+
+    FrameRecording::SegmentHeader header{};
+    header.magic = FrameRecording::SEGMENT_MAGIC;
+    header.version = FrameRecording::FORMAT_VERSION;
+    header.width = static_cast<uint16_t>(source.getWidth());
+    header.height = static_cast<uint16_t>(source.getHeight());
+    header.bytesPerPixel = 4;
+    segment.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    segmentWritten = sizeof(header);
+    framesSinceKeyframe = 0; // Every segment must start with a keyframe
+
+    pruneSegments();
+}
+
+void FrameRecorder::pruneSegments() const {
+    std::vector<fs::directory_entry> segments;
+    size_t total = 0;
+    try {
+        for (const auto& entry : fs::directory_iterator(directory)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".pprec") {
+                segments.push_back(entry);
+                total += entry.file_size();
+            }
+        }
+
+        // Names embed the start time, so sorting by name sorts oldest first
+        std::sort(segments.begin(), segments.end(),
+                  [](const fs::directory_entry& a, const fs::directory_entry& b) { return a.path() < b.path(); });
+
+        // Never delete the newest segment; it is the one being written
+        for (size_t i = 0; i + 1 < segments.size() && total > maxTotalBytes; ++i) {
+            total -= segments[i].file_size();
+            fs::remove(segments[i].path());
+        }
+    } catch (const fs::filesystem_error& e) {
+        std::cerr << "Frame recorder: error pruning old segments: " << e.what() << std::endl;
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "IDisplay.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <fstream>
+#include <cstdint>
+
+// Records every displayed frame into a rolling on-disk log (see FrameRecording.h).
+//
+// output() only copies the front buffer into a preallocated slot and hands it to a
+// background thread, which delta-encodes, compresses and writes it. If the writer falls
+// behind and all slots are in use the frame is dropped rather than blocking the render loop.
+class FrameRecorder : public IDisplay {
+public:
+    FrameRecorder(std::string directory, const FrameSource& source,
+                  size_t segmentBytes = 4 * 1024 * 1024, size_t maxTotalBytes = 64 * 1024 * 1024);
+    ~FrameRecorder() override;
+
+    void output() override;
+    [[nodiscard]] const char* name() const override { return "recorder"; }
+
+    [[nodiscard]] uint64_t framesRecorded() const { return recorded; }
+    [[nodiscard]] uint64_t framesDropped() const { return dropped; }
+
+private:
+    static constexpr size_t SLOT_COUNT = 8;
+    static constexpr int KEYFRAME_INTERVAL = 600;
+
+    struct PendingFrame {
+        uint64_t timestampMs;
+        std::vector<uint8_t> pixels;
+    };
+
+    std::string directory;
+    size_t segmentBytes;
+    size_t maxTotalBytes;
+    size_t frameBytes;
+    size_t rowBytes;
+
+    // Slots cycle between freeSlots (owned by output()) and pending (owned by the writer)
+    std::vector<PendingFrame> slots;
+    std::vector<PendingFrame*> freeSlots;
+    std::deque<PendingFrame*> pending;
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    bool stopping = false;
+    std::thread writerThread;
+
+    std::atomic<uint64_t> recorded{0};
+    std::atomic<uint64_t> dropped{0};
+
+    // --- Writer thread state ---
+    std::ofstream segment;
+    size_t segmentWritten = 0;
+    int framesSinceKeyframe = 0;
+    std::vector<uint8_t> previous;
+    std::vector<uint8_t> rowBitmap;
+    std::vector<uint8_t> payload;
+    std::vector<uint8_t> compressed;
+
+    void writerLoop();
+    void writeFrame(const PendingFrame& frame);
+    void openSegment(uint64_t timestampMs);
+    void pruneSegments() const;
+};
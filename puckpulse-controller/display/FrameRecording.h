@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+// On-disk format shared by FrameRecorder and FramePlayer.
+//
+// A recording is a directory of segment files named frames-<unix ms>.pprec. Each segment
+// starts with a SegmentHeader followed by frame records:
+//
+//   RecordHeader | changed-row bitmap ((height + 7) / 8 bytes) | LZ4 payload
+//
+// The payload holds only the rows flagged in the bitmap. In a keyframe every row is
+// flagged and stored as-is; in a delta frame each stored row is XORed with the same row
+// of the previous frame, which leaves mostly zero bytes for LZ4 to squeeze. The first
+// record of every segment is a keyframe, so old segments can be deleted independently.
+
+namespace FrameRecording {
+    constexpr uint32_t SEGMENT_MAGIC = 0x43525050; // "PPRC"
+    constexpr uint16_t FORMAT_VERSION = 1;
+
+    struct SegmentHeader {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t width;
+        uint16_t height;
+        uint16_t bytesPerPixel;
+    };
+
+    struct RecordHeader {
+        uint64_t timestampMs; // Unix time in milliseconds
+        uint8_t keyframe;
+        uint8_t reserved[3];
+        uint32_t compressedSize;
+    };
+
+    inline int bitmapBytes(const int height) { return (height + 7) / 8; }
+}
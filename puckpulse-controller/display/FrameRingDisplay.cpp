@@ -0,0 +1,14 @@
+#include "FrameRingDisplay.h"
+#include <iostream>
+
+FrameRingDisplay::FrameRingDisplay(const std::string& name, const FrameSource& source)
+    : IDisplay(source) {
+    if (!ring.create(name, source.getWidth(), source.getHeight())) {
+        std::cerr << "Failed to create frame ring " << name << ". Out-of-process displays will not receive frames." << std::endl;
+    }
+}
+
+void FrameRingDisplay::output() {
+    ring.publish(source.getFrontData());
+    countSent(1, static_cast<uint64_t>(source.getWidth()) * source.getHeight() * 4);
+}
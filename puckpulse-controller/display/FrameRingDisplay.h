@@ -0,0 +1,18 @@
+#pragma once
+
+#include "IDisplay.h"
+#include "SharedFrameRing.h"
+#include <string>
+
+// Publishes every swapped frame into a SharedFrameRing so display drivers running as
+// separate processes (puckpulse-display-driver) can send it to the hardware.
+class FrameRingDisplay : public IDisplay {
+public:
+    FrameRingDisplay(const std::string& name, const FrameSource& source);
+
+    void output() override;
+    [[nodiscard]] const char* name() const override { return "frame-ring"; }
+
+private:
+    SharedFrameRing ring;
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+// Anything a display can read finished frames from: the in-process DoubleFramebuffer,
+// or a SharedFrameRing mapped by an out-of-process display driver.
+class FrameSource {
+public:
+    virtual ~FrameSource() = default;
+
+    virtual const uint8_t* getFrontData() const = 0;
+    [[nodiscard]] virtual int getWidth() const = 0;
+    [[nodiscard]] virtual int getHeight() const = 0;
+};
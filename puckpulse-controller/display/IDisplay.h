@@ -1,12 +1,36 @@
 #pragma once
-class DoubleFramebuffer;
+#include <atomic>
+#include <cstdint>
+
+class FrameSource;
 
 class IDisplay {
 public:
     virtual ~IDisplay() = default;
 
-    IDisplay(DoubleFramebuffer& buffer) : dfb(buffer) {}    // The display takes the buffer and pushes it to its hardware/window
+    IDisplay(const FrameSource& source) : source(source) {}    // The display takes finished frames and pushes them to its hardware/window
     virtual void output() = 0;
+
+    // Short name used in logs and metrics, e.g. "ddp"
+    [[nodiscard]] virtual const char* name() const = 0;
+
+    // Totals handed to the hardware (or consumer) so far; readable from any thread
+    [[nodiscard]] uint64_t packetsSent() const { return m_packetsSent.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t bytesSent() const { return m_bytesSent.load(std::memory_order_relaxed); }
+    // Packets the kernel refused (e.g. a full socket buffer), so they never left this host
+    [[nodiscard]] uint64_t packetsDropped() const { return m_packetsDropped.load(std::memory_order_relaxed); }
 protected:
-    DoubleFramebuffer& dfb;
+    const FrameSource& source;
+
+    void countSent(const uint64_t packets, const uint64_t bytes) {
+        m_packetsSent.fetch_add(packets, std::memory_order_relaxed);
+        m_bytesSent.fetch_add(bytes, std::memory_order_relaxed);
+    }
+    void countDropped(const uint64_t packets) {
+        m_packetsDropped.fetch_add(packets, std::memory_order_relaxed);
+    }
+private:
+    std::atomic<uint64_t> m_packetsSent{0};
+    std::atomic<uint64_t> m_bytesSent{0};
+    std::atomic<uint64_t> m_packetsDropped{0};
 };
@@ -0,0 +1,66 @@
+#include "LedPreview.h"
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/BlendMode.hpp>
+#include <iostream>
+
+LedPreview::LedPreview(const unsigned int width, const unsigned int height, const unsigned int pixelSize, const unsigned int pixelGap)
+    : width(width), height(height), pitch(pixelSize + pixelGap) {
+    if (!texture.resize({width, height})) {
+        std::cerr << "Failed to create preview texture (" << width << "x" << height << ")" << std::endl;
+    }
+    texture.setSmooth(false);
+    rgba.resize(static_cast<size_t>(width) * height * 4);
+
+    buildDotMask(pixelSize);
+}
+
+void LedPreview::buildDotMask(const unsigned int pixelSize) {
+    dots.clear();
+    dots.reserve(static_cast<size_t>(width) * height * 6);
+
+    const auto size = static_cast<float>(pixelSize);
+    for (unsigned int y = 0; y < height; ++y) {
+        for (unsigned int x = 0; x < width; ++x) {
+            const auto left = static_cast<float>(x * pitch);
+            const auto top = static_cast<float>(y * pitch);
+            const sf::Vector2f texel(static_cast<float>(x) + 0.5f, static_cast<float>(y) + 0.5f);
+
+            // Two triangles per dot, all sampling the same texel
+            dots.push_back({{left, top}, sf::Color::White, texel});
+            dots.push_back({{left + size, top}, sf::Color::White, texel});
+            dots.push_back({{left, top + size}, sf::Color::White, texel});
+            dots.push_back({{left + size, top}, sf::Color::White, texel});
+            dots.push_back({{left + size, top + size}, sf::Color::White, texel});
+            dots.push_back({{left, top + size}, sf::Color::White, texel});
+        }
+    }
+
+    // Keep the geometry on the GPU if we can; otherwise fall back to drawing the array
+    if (sf::VertexBuffer::isAvailable() && dotBuffer.create(dots.size()) && dotBuffer.update(dots.data())) {
+        useVertexBuffer = true;
+        dots.clear();
+        dots.shrink_to_fit();
+    }
+}
+
+void LedPreview::update(const uint8_t* bgra) {
+    const size_t count = static_cast<size_t>(width) * height;
+    for (size_t i = 0; i < count; ++i) {
+        rgba[i * 4 + 0] = bgra[i * 4 + 2]; // Red
+        rgba[i * 4 + 1] = bgra[i * 4 + 1]; // Green
+        rgba[i * 4 + 2] = bgra[i * 4 + 0]; // Blue
+        rgba[i * 4 + 3] = 255;
+    }
+    texture.update(rgba.data());
+}
+
+void LedPreview::draw(sf::RenderTarget& target) const {
+    sf::RenderStates states(&texture);
+    states.blendMode = sf::BlendNone;
+
+    if (useVertexBuffer) {
+        target.draw(dotBuffer, states);
+    } else {
+        target.draw(dots.data(), dots.size(), sf::PrimitiveType::Triangles, states);
+    }
+}
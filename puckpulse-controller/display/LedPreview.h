@@ -0,0 +1,38 @@
+#pragma once
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <vector>
+#include <cstdint>
+
+// Draws a framebuffer as a grid of LED dots in a single draw call.
+//
+// The frame is uploaded into a texture at its native size. The dot layout (one quad per
+// LED, with a gap between neighbours) is built once and kept on the GPU when vertex
+// buffers are available; every vertex of a quad samples the centre of its texel, so each
+// dot is filled with exactly one pixel colour.
+class LedPreview {
+public:
+    LedPreview(unsigned int width, unsigned int height, unsigned int pixelSize, unsigned int pixelGap);
+
+    // Upload a BGRA frame (the DoubleFramebuffer layout)
+    void update(const uint8_t* bgra);
+    void draw(sf::RenderTarget& target) const;
+
+    [[nodiscard]] sf::Vector2u getSize() const { return {width * pitch, height * pitch}; }
+
+private:
+    unsigned int width, height;
+    unsigned int pitch; // pixel size + gap
+
+    sf::Texture texture;
+    std::vector<std::uint8_t> rgba;
+
+    std::vector<sf::Vertex> dots;
+    sf::VertexBuffer dotBuffer{sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Static};
+    bool useVertexBuffer = false;
+
+    void buildDotMask(unsigned int pixelSize);
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+
+// The framebuffer holds Blend2D PRGB32 pixels, which are stored in memory as B, G, R, A.
+// Every LED output drops the alpha byte and writes the three colour channels in the
+// order its receiver expects, so the swizzle lives here and is shared by all backends.
+
+enum class ChannelOrder {
+    BGR, // ColorLight receiver cards
+    RGB  // DDP / WLED / Falcon controllers
+};
+
+inline void packPixels(const uint8_t* src, uint8_t* dst, const int count, const ChannelOrder order) {
+    if (order == ChannelOrder::BGR) {
+        for (int i = 0; i < count; ++i) {
+            dst[i * 3 + 0] = src[i * 4 + 0]; // Blue
+            dst[i * 3 + 1] = src[i * 4 + 1]; // Green
+            dst[i * 3 + 2] = src[i * 4 + 2]; // Red
+        }
+    } else {
+        for (int i = 0; i < count; ++i) {
+            dst[i * 3 + 0] = src[i * 4 + 2]; // Red
+            dst[i * 3 + 1] = src[i * 4 + 1]; // Green
+            dst[i * 3 + 2] = src[i * 4 + 0]; // Blue
+        }
+    }
+}
@@ -3,27 +3,18 @@
 //
 
 #include "SFMLDisplay.h"
-#include "DoubleFramebuffer.h"
+#include "FrameSource.h"
 #include <iostream>
 #include <SFML/Window/Event.hpp>
-#include <SFML/Graphics/RectangleShape.hpp>
-#include <SFML/Graphics/Color.hpp>
 
 
-SFMLDisplay::SFMLDisplay(DoubleFramebuffer& buffer)
-    : IDisplay(buffer)
+SFMLDisplay::SFMLDisplay(const FrameSource& source)
+    : IDisplay(source),
+      // Window size is based on pixel size and gap
+      window(sf::VideoMode({source.getWidth() * (PIXEL_SIZE + PIXEL_GAP), source.getHeight() * (PIXEL_SIZE + PIXEL_GAP)}), "Preview"),
+      preview(source.getWidth(), source.getHeight(), PIXEL_SIZE, PIXEL_GAP)
 {
-    auto w = static_cast<unsigned int>(dfb.getWidth());
-    auto h = static_cast<unsigned int>(dfb.getHeight());
-
-    // Calculate window size based on pixel size and gap
-    unsigned int windowWidth = w * (PIXEL_SIZE + PIXEL_GAP);
-    unsigned int windowHeight = h * (PIXEL_SIZE + PIXEL_GAP);
-
-    window.create(sf::VideoMode({windowWidth, windowHeight}), "Preview");
-    // Removed sprite.setScale(...) as we draw individual shapes now
-
-    std::cout << "SFML initialized at " << w << "x" << h << std::endl;
+    std::cout << "SFML initialized at " << source.getWidth() << "x" << source.getHeight() << std::endl;
 }
 
 void SFMLDisplay::output() {
@@ -37,39 +28,15 @@ void SFMLDisplay::output() {
             window.close();
     }
 
-    window.clear(); // Clear to black
-
     if (!window.isOpen()) { // Check again in case it was closed in event loop
         return;
     }
 
-    // Get pixel data from framebuffer
-    const uint8_t* pixels = dfb.getFrontData();
-    unsigned int fbWidth = dfb.getWidth();
-    unsigned int fbHeight = dfb.getHeight();
+    window.clear(); // Clear to black; the gaps between dots stay black
 
-    // Create a shape to represent each pixel (can be reused for efficiency if needed)
-    sf::RectangleShape pixelShape(sf::Vector2f(static_cast<float>(PIXEL_SIZE), static_cast<float>(PIXEL_SIZE)));
-
-    for (unsigned int y = 0; y < fbHeight; ++y) {
-        for (unsigned int x = 0; x < fbWidth; ++x) {
-            unsigned int index = (y * fbWidth + x) * 4; // RGBA format
-
-            uint8_t b = pixels[index + 0];
-            uint8_t g = pixels[index + 1];
-            uint8_t r = pixels[index + 2];
-            uint8_t a = pixels[index + 3]; // Alpha not used for display color
-
-            pixelShape.setFillColor(sf::Color(r, g, b, a));
-            pixelShape.setPosition(
-                sf::Vector2f(
-                    static_cast<float>(x * (PIXEL_SIZE + PIXEL_GAP)),
-                    static_cast<float>(y * (PIXEL_SIZE + PIXEL_GAP))
-                )
-            );
-            window.draw(pixelShape);
-        }
-    }
+    // Upload the front buffer once and draw every LED dot in a single call
+    preview.update(source.getFrontData());
+    preview.draw(window);
 
     window.display();
 }
@@ -1,20 +1,23 @@
 #pragma once
 
 #include "IDisplay.h"
+#include "LedPreview.h"
 #include <SFML/Graphics/RenderWindow.hpp>
 
-class DoubleFramebuffer;
+class FrameSource;
 
 class SFMLDisplay : public IDisplay {
-    sf::RenderWindow window;
+    static constexpr unsigned int PIXEL_SIZE = 4; // Size of each simulated pixel
+    static constexpr unsigned int PIXEL_GAP = 1;  // Gap between simulated pixels
 
-    const unsigned int PIXEL_SIZE = 4; // Size of each simulated pixel
-    const unsigned int PIXEL_GAP = 1;  // Gap between simulated pixels
+    sf::RenderWindow window;
+    LedPreview preview;
 
 public:
-    explicit SFMLDisplay(DoubleFramebuffer& buffer);
+    explicit SFMLDisplay(const FrameSource& source);
 
     void output() override;
+    [[nodiscard]] const char* name() const override { return "sfml"; }
     bool isOpen() const;
     sf::RenderWindow& getWindow() { return window; }
-};
\ No newline at end of file
+};
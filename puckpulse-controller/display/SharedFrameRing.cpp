@@ -0,0 +1,206 @@
+#include "SharedFrameRing.h"
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <cerrno>
+#include <new>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#define FRAME_RING_MAGIC 0x50504652 // "PPFR"
+#define FRAME_RING_VERSION 1
+
+// The segment is shared between processes, so the futex must not use FUTEX_PRIVATE_FLAG
+// (which is also why std::atomic::wait cannot be used here).
+static void futexWait(std::atomic<uint32_t>* word, uint32_t expected, int timeoutMs) {
+    timespec timeout{timeoutMs / 1000, (timeoutMs % 1000) * 1000000L};
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+}
+
+static void futexWakeAll(std::atomic<uint32_t>* word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+}
+
+SharedFrameRing::~SharedFrameRing() {
+    unmap();
+}
+
+size_t SharedFrameRing::slotStrideFor(const uint32_t width, const uint32_t height) {
+    // Keep every slot's pixel data cache-line aligned
+    return sizeof(SlotHeader) + ((frameBytes(width, height) + 63) & ~static_cast<size_t>(63));
+}
+
+SharedFrameRing::SlotHeader* SharedFrameRing::slot(const uint64_t sequence) const {
+    auto* base = reinterpret_cast<uint8_t*>(header) + sizeof(Header);
+    return reinterpret_cast<SlotHeader*>(base + (sequence % header->slotCount) * header->slotStride);
+}
+
+uint8_t* SharedFrameRing::slotData(SlotHeader* slot) const {
+    return reinterpret_cast<uint8_t*>(slot) + sizeof(SlotHeader);
+}
+
+bool SharedFrameRing::create(const std::string& name, const int width, const int height) {
+    const auto w = static_cast<uint32_t>(width);
+    const auto h = static_cast<uint32_t>(height);
+    const size_t size = sizeof(Header) + SLOT_COUNT * slotStrideFor(w, h);
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0660);
+    if (fd < 0) {
+        perror("Frame ring shm_open failed");
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) < 0) {
+        perror("Frame ring ftruncate failed");
+        close(fd);
+        return false;
+    }
+
+    void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        perror("Frame ring mmap failed");
+        return false;
+    }
+
+    mapping = addr;
+    mappingSize = size;
+    header = static_cast<Header*>(addr);
+    writer = true;
+
+    // Reuse a ring left behind by a previous run so drivers keep their mapping and the
+    // sequence keeps increasing; otherwise lay out a fresh one.
+    if (header->magic != FRAME_RING_MAGIC || header->version != FRAME_RING_VERSION ||
+        header->width != w || header->height != h || header->slotCount != SLOT_COUNT) {
+        new (header) Header{};
+        header->version = FRAME_RING_VERSION;
+        header->width = w;
+        header->height = h;
+        header->slotCount = SLOT_COUNT;
+        header->slotStride = static_cast<uint32_t>(slotStrideFor(w, h));
+        for (uint32_t i = 0; i < SLOT_COUNT; ++i) {
+            new (slot(i)) SlotHeader{};
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        header->magic = FRAME_RING_MAGIC;
+    }
+
+    std::cout << "Frame ring " << name << " ready (" << width << "x" << height << ", "
+              << SLOT_COUNT << " slots, " << size / 1024 << " KB)" << std::endl;
+    return true;
+}
+
+void SharedFrameRing::publish(const uint8_t* frame) {
+    if (!header || !writer) return;
+
+    const uint64_t sequence = header->latestSequence.load(std::memory_order_relaxed) + 1;
+    SlotHeader* s = slot(sequence);
+
+    // Seqlock write: mark the slot as in progress before touching the pixels
+    s->sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    memcpy(slotData(s), frame, frameBytes(header->width, header->height));
+    s->timestampNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+
+    s->sequence.store(sequence, std::memory_order_release);
+    header->latestSequence.store(sequence, std::memory_order_release);
+    header->futexWord.fetch_add(1, std::memory_order_release);
+    futexWakeAll(&header->futexWord);
+}
+
+bool SharedFrameRing::open(const std::string& name) {
+    unmap();
+
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return false; // The controller has not created the ring yet
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) < 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+        close(fd);
+        return false;
+    }
+
+    void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        perror("Frame ring mmap failed");
+        return false;
+    }
+
+    mapping = addr;
+    mappingSize = st.st_size;
+    header = static_cast<Header*>(addr);
+    writer = false;
+
+    const size_t expected = sizeof(Header) + static_cast<size_t>(header->slotCount) * header->slotStride;
+    if (header->magic != FRAME_RING_MAGIC || header->version != FRAME_RING_VERSION || mappingSize < expected) {
+        std::cerr << "Frame ring " << name << " has an unexpected layout" << std::endl;
+        unmap();
+        return false;
+    }
+    return true;
+}
+
+uint64_t SharedFrameRing::latestSequence() const {
+    return header ? header->latestSequence.load(std::memory_order_acquire) : 0;
+}
+
+uint64_t SharedFrameRing::waitForFrame(const uint64_t lastSequence, const int timeoutMs) {
+    if (!header) return lastSequence;
+
+    uint64_t latest = latestSequence();
+    if (latest != lastSequence) return latest;
+
+    const uint32_t word = header->futexWord.load(std::memory_order_acquire);
+    latest = latestSequence();
+    if (latest != lastSequence) return latest;
+
+    futexWait(&header->futexWord, word, timeoutMs);
+    return latestSequence();
+}
+
+bool SharedFrameRing::select(const uint64_t sequence) {
+    if (!header || sequence == 0) return false;
+
+    SlotHeader* s = slot(sequence);
+    if (s->sequence.load(std::memory_order_acquire) != sequence) {
+        return false; // Still being written or already reused
+    }
+    selectedSlot = s;
+    selectedSequence = sequence;
+    selectedData = slotData(s);
+    return true;
+}
+
+bool SharedFrameRing::isIntact() const {
+    if (!selectedSlot) return false;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return selectedSlot->sequence.load(std::memory_order_relaxed) == selectedSequence;
+}
+
+int SharedFrameRing::getWidth() const {
+    return header ? static_cast<int>(header->width) : 0;
+}
+
+int SharedFrameRing::getHeight() const {
+    return header ? static_cast<int>(header->height) : 0;
+}
+
+void SharedFrameRing::unmap() {
+    if (mapping) {
+        munmap(mapping, mappingSize);
+    }
+    mapping = nullptr;
+    mappingSize = 0;
+    header = nullptr;
+    selectedData = nullptr;
+    selectedSlot = nullptr;
+    selectedSequence = 0;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "FrameSource.h"
+#include <string>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+// A ring of finished frames in POSIX shared memory, written by the controller and read
+// by out-of-process display drivers.
+//
+// The controller copies each swapped frame into the next slot and then publishes its
+// sequence number. Drivers map the same segment read-only and send straight out of the
+// slot (no copy). A slot is only rewritten after SLOT_COUNT newer frames, so a reader
+// that checks the slot sequence again after sending can tell whether it was overwritten.
+//
+// Either side can be restarted at any time: the controller reuses an existing segment of
+// the right size and keeps counting, and drivers simply map it again.
+class SharedFrameRing : public FrameSource {
+public:
+    static constexpr const char* DEFAULT_NAME = "/puckpulse-frames";
+    static constexpr uint32_t SLOT_COUNT = 4;
+
+    SharedFrameRing() = default;
+    ~SharedFrameRing() override;
+
+    SharedFrameRing(const SharedFrameRing&) = delete;
+    SharedFrameRing& operator=(const SharedFrameRing&) = delete;
+
+    // --- WRITER (controller) ---
+    bool create(const std::string& name, int width, int height);
+    void publish(const uint8_t* frame);
+
+    // --- READER (display driver) ---
+    bool open(const std::string& name);
+    // Blocks until a frame newer than lastSequence is published or the timeout expires.
+    // Returns the newest sequence number (== lastSequence on timeout).
+    uint64_t waitForFrame(uint64_t lastSequence, int timeoutMs);
+    // Makes the frame with this sequence the one returned by getFrontData()
+    bool select(uint64_t sequence);
+    // True if the selected frame has not been overwritten since select()
+    [[nodiscard]] bool isIntact() const;
+
+    // --- FrameSource ---
+    const uint8_t* getFrontData() const override { return selectedData; }
+    [[nodiscard]] int getWidth() const override;
+    [[nodiscard]] int getHeight() const override;
+
+    [[nodiscard]] bool isOpen() const { return header != nullptr; }
+    [[nodiscard]] uint64_t latestSequence() const;
+
+private:
+    struct alignas(64) Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t width;
+        uint32_t height;
+        uint32_t slotCount;
+        uint32_t slotStride;
+        std::atomic<uint64_t> latestSequence;
+        std::atomic<uint32_t> futexWord; // bumped on every publish so readers can sleep on it
+    };
+
+    struct alignas(64) SlotHeader {
+        std::atomic<uint64_t> sequence; // 0 while the slot is being written
+        uint64_t timestampNs;
+    };
+
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+    Header* header = nullptr;
+    bool writer = false;
+
+    const uint8_t* selectedData = nullptr;
+    const SlotHeader* selectedSlot = nullptr;
+    uint64_t selectedSequence = 0;
+
+    static size_t frameBytes(uint32_t width, uint32_t height) { return static_cast<size_t>(width) * height * 4; }
+    static size_t slotStrideFor(uint32_t width, uint32_t height);
+
+    SlotHeader* slot(uint64_t sequence) const;
+    uint8_t* slotData(SlotHeader* slot) const;
+    void unmap();
+};
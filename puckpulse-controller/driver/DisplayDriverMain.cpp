@@ -0,0 +1,184 @@
+// puckpulse-display-driver: sends frames published by the controller's shared-memory frame
+// ring to LED hardware from a separate process.
+//
+// Keeping the output path out of the controller means a stalled NIC or receiver card can
+// never hold up game logic, only this process needs the raw socket capability, and it can
+// run at realtime priority on its own core. The driver can be restarted at any time.
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <csignal>
+#include <atomic>
+
+#include "../display/SharedFrameRing.h"
+#include "../display/ColorLightDisplay.h"
+#include "../display/DDPDisplay.h"
+#include "../Realtime.h"
+#include "../Tracer.h"
+#include "../Log.h"
+
+std::atomic<bool> g_running{true};
+std::atomic<bool> g_dumpTrace{false};
+
+void signalHandler(int) {
+    g_running = false;
+}
+
+void traceSignalHandler(int) {
+    g_dumpTrace = true;
+}
+
+static void dumpTrace() {
+    std::string path = Tracer::dumpToFile();
+    if (!path.empty()) {
+        std::cout << "Trace written to " << path << std::endl;
+    }
+}
+
+struct DriverArgs {
+    std::string ringName = SharedFrameRing::DEFAULT_NAME;
+    std::string colorLightInterface;
+    std::string ddpHost;
+    uint16_t ddpPort = DDPDisplay::DEFAULT_PORT;
+    int rtPriority = 0;
+    int cpu = -1;
+    std::string traceDir; // Empty: tracing disabled
+};
+
+static void printHelp(const char* appName) {
+    std::cout << "Usage: " << appName << " [OPTIONS]" << std::endl;
+    std::cout << "  -r, --ring <name>        Shared-memory frame ring to read (default: " << SharedFrameRing::DEFAULT_NAME << ")" << std::endl;
+    std::cout << "  -c, --colorlight <iface> Send frames to a ColorLight receiver on this interface" << std::endl;
+    std::cout << "  -d, --ddp <host[:port]>  Send frames to a DDP pixel controller" << std::endl;
+    std::cout << "      --rt-priority <1-99> Run the output loop with SCHED_FIFO at this priority" << std::endl;
+    std::cout << "      --cpu <n>            Pin the output loop to this CPU core" << std::endl;
+    std::cout << "      --trace <dir>        Record a Chrome/Perfetto trace, written to dir on exit and on kill -USR2" << std::endl;
+    std::cout << "  -h, --help               Show this help message" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    DriverArgs args;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if ((arg == "-r" || arg == "--ring") && hasValue) {
+            args.ringName = argv[++i];
+        } else if ((arg == "-c" || arg == "--colorlight") && hasValue) {
+            args.colorLightInterface = argv[++i];
+        } else if ((arg == "-d" || arg == "--ddp") && hasValue) {
+            std::string target = argv[++i];
+            auto colon = target.find(':');
+            if (colon != std::string::npos) {
+                args.ddpPort = static_cast<uint16_t>(std::stoi(target.substr(colon + 1)));
+                target = target.substr(0, colon);
+            }
+            args.ddpHost = target;
+        } else if (arg == "--rt-priority" && hasValue) {
+            args.rtPriority = std::stoi(argv[++i]);
+        } else if (arg == "--cpu" && hasValue) {
+            args.cpu = std::stoi(argv[++i]);
+        } else if (arg == "--trace" && hasValue) {
+            args.traceDir = argv[++i];
+        } else {
+            printHelp(argv[0]);
+            return arg == "-h" || arg == "--help" ? 0 : 1;
+        }
+    }
+
+    if (args.colorLightInterface.empty() && args.ddpHost.empty()) {
+        std::cerr << "No output configured. Use -c and/or -d." << std::endl;
+        printHelp(argv[0]);
+        return 1;
+    }
+
+    std::signal(SIGINT, signalHandler);
+    std::signal(SIGTERM, signalHandler);
+    std::signal(SIGUSR2, traceSignalHandler);
+    // Output errors are logged from the output loop; the writer thread keeps stdout off it
+    Log::start();
+
+    if (!args.traceDir.empty()) {
+        Tracer::enable(args.traceDir);
+        Tracer::setThreadName("output");
+    }
+
+    if (args.cpu >= 0) pinCurrentThreadToCpu(args.cpu);
+    if (args.rtPriority > 0) {
+        lockProcessMemory();
+        setRealtimePriority(args.rtPriority);
+    }
+
+    SharedFrameRing ring;
+    bool announced = false;
+    while (g_running && !ring.open(args.ringName)) {
+        if (!announced) {
+            std::cout << "Waiting for frame ring " << args.ringName << " (is the controller running with --frame-ring?)" << std::endl;
+            announced = true;
+        }
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+    if (!g_running) {
+        Log::stop();
+        return 0;
+    }
+
+    std::cout << "Mapped frame ring " << args.ringName << " (" << ring.getWidth() << "x" << ring.getHeight() << ")" << std::endl;
+
+    std::vector<std::unique_ptr<IDisplay>> displays;
+    if (!args.colorLightInterface.empty()) {
+        displays.push_back(std::make_unique<ColorLightDisplay>(args.colorLightInterface, ring));
+    }
+    if (!args.ddpHost.empty()) {
+        displays.push_back(std::make_unique<DDPDisplay>(args.ddpHost, args.ddpPort, ring));
+    }
+
+    uint64_t lastSequence = ring.latestSequence();
+    uint64_t framesSent = 0, framesSkipped = 0, framesTorn = 0;
+
+    while (g_running) {
+        // Writing a full trace takes a while; keep it off the output thread, and off its
+        // realtime priority and core, which a new thread would otherwise inherit
+        if (g_dumpTrace.exchange(false) && Tracer::enabled()) {
+            std::thread([] {
+                resetThreadScheduling();
+                dumpTrace();
+            }).detach();
+        }
+
+        uint64_t sequence = ring.waitForFrame(lastSequence, 500);
+        if (sequence == lastSequence) continue;
+
+        // The controller only publishes on change; if we fell behind, send the newest frame
+        if (lastSequence != 0 && sequence > lastSequence + 1) {
+            framesSkipped += sequence - lastSequence - 1;
+        }
+        lastSequence = sequence;
+
+        if (!ring.select(sequence)) {
+            framesSkipped++;
+            continue;
+        }
+
+        for (auto& disp : displays) {
+            TRACE_SCOPE("display", disp->name());
+            disp->output();
+        }
+
+        if (!ring.isIntact()) {
+            framesTorn++; // The controller lapped the ring while we were sending
+        }
+        framesSent++;
+    }
+
+    std::cout << "Display driver stopped. Sent " << framesSent << " frames ("
+              << framesSkipped << " skipped, " << framesTorn << " torn)" << std::endl;
+    if (Tracer::enabled()) {
+        dumpTrace();
+    }
+    Log::stop();
+    return 0;
+}
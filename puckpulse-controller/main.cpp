@@ -5,19 +5,39 @@
 #include <thread>
 #include <csignal>
 #include <atomic>
+#include <algorithm>
+#include <iomanip>
+#include <ctime>
+#include <memory>
+#include <sstream>
 
 #include "display/DoubleFramebuffer.h"
 #include "display/ColorLightDisplay.h"
+#include "display/DDPDisplay.h"
+#include "display/FrameRingDisplay.h"
+#include "display/FrameRecorder.h"
+#include "display/FramePlayer.h"
 #include "ScoreboardController.h"
 #include "ScoreboardRenderer.h"
 #include "GoalCelebrationRenderer.h"
+#include "DiagnosticOverlay.h"
+#include "SoakTest.h"
 #include "IRenderer.h"
 #include "network/NetworkManager.h"
 #include "network/WebSocketManager.h"
+#include "network/FrameStreamer.h"
+#include "network/HttpEndpoint.h"
+#include "network/ImageCache.h"
 #include "network/Base64Coder.h"
 #include "TeamManager.h"
 #include "CommandLineArgs.h"
 #include "ResourceLocator.h"
+#include "Realtime.h"
+#include "JitterHistogram.h"
+#include "Metrics.h"
+#include "Tracer.h"
+#include "Log.h"
+#include "AllocationTracker.h"
 
 #ifdef ENABLE_SFML
 #include "display/SFMLDisplay.h"
@@ -25,12 +45,29 @@
 #endif
 
 std::atomic<bool> g_running{true};
+std::atomic<bool> g_printJitter{false};
+std::atomic<bool> g_dumpTrace{false};
 
 void signalHandler(int signum) {
     std::cout << "\nInterrupt signal (" << signum << ") received. Shutting down..." << std::endl;
     g_running = false;
 }
 
+void jitterSignalHandler(int) {
+    g_printJitter = true;
+}
+
+void traceSignalHandler(int) {
+    g_dumpTrace = true;
+}
+
+static void dumpTrace() {
+    std::string path = Tracer::dumpToFile();
+    if (!path.empty()) {
+        std::cout << "Trace written to " << path << std::endl;
+    }
+}
+
 void printStartupBanner(const CommandLineArgs& args) {
 #ifdef ENABLE_SFML
     std::string buildType = "Standard";
@@ -45,6 +82,16 @@ void printStartupBanner(const CommandLineArgs& args) {
         std::cout << "ColorLight LED: Disabled" << std::endl;
     }
 
+    if (args.enableDDP()) {
+        std::cout << "DDP Output: Enabled (" << args.ddpHost() << ":" << args.ddpPort() << ")" << std::endl;
+    } else {
+        std::cout << "DDP Output: Disabled" << std::endl;
+    }
+
+    if (args.enableFrameRing()) {
+        std::cout << "Frame Ring: Enabled (" << args.frameRingName() << ")" << std::endl;
+    }
+
     if (args.enableSFML()) {
         std::cout << "SFML Display: Enabled" << std::endl;
     } else {
@@ -52,6 +99,34 @@ void printStartupBanner(const CommandLineArgs& args) {
     }
 }
 
+// Plays a recorded time window on the enabled displays at its original pace
+static int runReplay(const CommandLineArgs& args, const std::string& recordingDir, DoubleFramebuffer& dfb, const std::vector<IDisplay*>& displays) {
+    std::cout << "Replaying recorded frames from " << recordingDir << std::endl;
+
+    auto replayStart = std::chrono::steady_clock::now();
+    uint64_t firstTimestamp = 0;
+
+    FramePlayer player(recordingDir);
+    size_t frames = player.play(args.replayFromMs(), args.replayToMs(), dfb.getWidth(), dfb.getHeight(),
+        [&](uint64_t timestampMs, const uint8_t* pixels) {
+            if (firstTimestamp == 0) firstTimestamp = timestampMs;
+            std::this_thread::sleep_until(replayStart + std::chrono::milliseconds(timestampMs - firstTimestamp));
+
+            std::copy_n(pixels, dfb.getWidth() * dfb.getHeight() * 4, dfb.getBackData());
+            dfb.swap();
+            for (IDisplay* disp : displays) {
+                disp->output();
+            }
+
+            std::time_t seconds = static_cast<std::time_t>(timestampMs / 1000);
+            std::cout << "\r" << std::put_time(std::localtime(&seconds), "%Y-%m-%d %H:%M:%S") << std::flush;
+            return g_running.load();
+        });
+
+    std::cout << std::endl << "Replayed " << frames << " frames" << std::endl;
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
     CommandLineArgs args(argc, argv);
     printStartupBanner(args);
@@ -61,6 +136,9 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
+    Log::setLevel(args.logLevel());
+    Log::start();
+
     int w = 384, h = 160;
 
     DoubleFramebuffer dfb(w, h);
@@ -79,30 +157,177 @@ int main(int argc, char* argv[]) {
         displays.push_back(clDisplay);
     }
 
+    if (args.enableDDP()) {
+        displays.push_back(new DDPDisplay(args.ddpHost(), args.ddpPort(), dfb));
+    }
+
+    if (args.enableFrameRing()) {
+        displays.push_back(new FrameRingDisplay(args.frameRingName(), dfb));
+    }
+
+    ResourceLocator resourceLocator;
+    std::string recordingDir = args.recordingDir().empty()
+        ? resourceLocator.getDataDirPath() + "/recordings"
+        : args.recordingDir();
+
+    if (args.enableTracing()) {
+        std::string traceDir = args.traceDir().empty()
+            ? resourceLocator.getDataDirPath() + "/traces"
+            : args.traceDir();
+        Tracer::enable(traceDir);
+        Tracer::setThreadName("main");
+        std::cout << "Tracing enabled (dump with kill -USR2 or GET /trace; written to " << traceDir << ")" << std::endl;
+    }
+
+    if (args.soak()) {
+        std::signal(SIGINT, signalHandler);
+        std::signal(SIGTERM, signalHandler);
+        if (args.cpu() >= 0) {
+            pinCurrentThreadToCpu(args.cpu());
+        }
+        if (args.enableRealtime()) {
+            lockProcessMemory();
+            setRealtimePriority(args.realtimePriority());
+        }
+        SoakTest soak(dfb, displays);
+        int result = soak.run({args.soakSeconds(), args.soakPattern(), args.soakMaxFps()}, g_running);
+        for (IDisplay* disp : displays) {
+            delete disp;
+        }
+        Log::stop();
+        return result;
+    }
+
+    if (args.replay()) {
+        std::signal(SIGINT, signalHandler);
+        std::signal(SIGTERM, signalHandler);
+        int result = runReplay(args, recordingDir, dfb, displays);
+        for (IDisplay* disp : displays) {
+            delete disp;
+        }
+        Log::stop();
+        return result;
+    }
+
     if (displays.empty()) {
-        std::cerr << "WARNING: No display enabled (SFML or ColorLight). Scoreboard will run in 'Logic Only' mode." << std::endl;
+        std::cerr << "WARNING: No display enabled (SFML, ColorLight, DDP or frame ring). Scoreboard will run in 'Logic Only' mode." << std::endl;
         std::cerr << "Remote control and configuration will still be available via the app." << std::endl;
     }
 
-    ResourceLocator resourceLocator;
+    FrameRecorder* recorder = nullptr;
+    if (args.enableRecording()) {
+        recorder = new FrameRecorder(recordingDir, dfb);
+        displays.push_back(recorder);
+    }
+
+    // Always fed, so apps can subscribe to a live preview of the board at any time
+    FrameStreamer* frameStreamer = new FrameStreamer(dfb);
+    displays.push_back(frameStreamer);
+
+    // --- METRICS ---
+    // Hot-path metrics are looked up once here; recording is a few relaxed atomic adds
+    Metrics metrics;
+    LatencyHistogram& updateTime = metrics.histogram("puckpulse_stage_seconds", "Main loop stage duration", "stage", "update");
+    LatencyHistogram& renderTime = metrics.histogram("puckpulse_stage_seconds", "Main loop stage duration", "stage", "render");
+    LatencyHistogram& swapTime = metrics.histogram("puckpulse_stage_seconds", "Main loop stage duration", "stage", "swap");
+    Counter& framesRendered = metrics.counter("puckpulse_frames_rendered_total", "Frames rendered and sent to the displays");
+    Counter& ticksMissed = metrics.counter("puckpulse_ticks_missed_total", "10ms ticks skipped because the main loop fell behind");
+
+    std::vector<LatencyHistogram*> outputTimes;
+    for (IDisplay* disp : displays) {
+        outputTimes.push_back(&metrics.histogram("puckpulse_display_output_seconds", "Time spent in IDisplay::output()", "display", disp->name()));
+        metrics.counterFunction("puckpulse_display_packets_sent_total", "Packets, messages or records sent by each display",
+                                [disp] { return static_cast<double>(disp->packetsSent()); }, "display", disp->name());
+        metrics.counterFunction("puckpulse_display_bytes_sent_total", "Bytes sent by each display",
+                                [disp] { return static_cast<double>(disp->bytesSent()); }, "display", disp->name());
+        metrics.counterFunction("puckpulse_display_packets_dropped_total", "Packets each display failed to hand to the kernel",
+                                [disp] { return static_cast<double>(disp->packetsDropped()); }, "display", disp->name());
+    }
+    for (size_t i = 0; i < AllocationTracker::SUBSYSTEM_COUNT; ++i) {
+        const auto subsystem = static_cast<AllocationSubsystem>(i);
+        metrics.counterFunction("puckpulse_allocations_total", "Heap allocations by subsystem",
+                                [subsystem] { return static_cast<double>(AllocationTracker::count(subsystem)); },
+                                "subsystem", AllocationTracker::name(subsystem));
+        metrics.counterFunction("puckpulse_allocated_bytes_total", "Heap bytes allocated by subsystem",
+                                [subsystem] { return static_cast<double>(AllocationTracker::bytes(subsystem)); },
+                                "subsystem", AllocationTracker::name(subsystem));
+    }
+    metrics.counterFunction("puckpulse_log_lines_dropped_total", "Log lines dropped because the log ring was full",
+                            [] { return static_cast<double>(Log::dropped()); });
+    if (recorder) {
+        metrics.counterFunction("puckpulse_recorder_frames_dropped_total", "Frames the recorder dropped because its writer fell behind",
+                                [recorder] { return static_cast<double>(recorder->framesDropped()); });
+    }
+
     TeamManager teamManager(resourceLocator.getDataDirPath());
     Base64Coder base64Coder;
     
     WebSocketManager* wsPtr = nullptr;
     
-    ScoreboardController scoreboard([&wsPtr](const ScoreboardState& state) {
-        if (wsPtr) wsPtr->broadcastState(state);
+    ScoreboardController scoreboard([&wsPtr](const ScoreboardSnapshot& snapshot) {
+        if (wsPtr) wsPtr->broadcastState(snapshot);
     });
 
-    WebSocketManager ws(9000, scoreboard, teamManager, base64Coder);
+    // Reads the same counters as /metrics; the overlay turns them into rates
+    DiagnosticOverlay overlay(dfb, resourceLocator, [&](DiagnosticSample& sample) {
+        sample.renders = renderTime.count();
+        sample.renderNs = renderTime.sumNs();
+        sample.displayCount = std::min(displays.size(), DiagnosticSample::MAX_DISPLAYS);
+        for (size_t i = 0; i < sample.displayCount; ++i) {
+            sample.displays[i] = {displays[i]->name(), outputTimes[i]->count(), displays[i]->packetsSent()};
+        }
+        if (wsPtr) {
+            sample.clients = wsPtr->clientCount();
+            wsPtr->lastCommand(sample.lastCommand, sample.lastCommandNs);
+        }
+    });
+    overlay.setEnabled(args.showDiagnostics());
+
+    metrics.gauge("puckpulse_state_version", "Version of the most recently published scoreboard state",
+                  [&scoreboard] { return static_cast<double>(scoreboard.snapshot()->version); });
+    metrics.gauge("puckpulse_command_queue_depth", "Scoreboard commands waiting for the next tick",
+                  [&scoreboard] { return static_cast<double>(scoreboard.pendingCommands()); });
+    metrics.counterFunction("puckpulse_commands_rejected_total", "Scoreboard commands dropped because the queue was full",
+                            [&scoreboard] { return static_cast<double>(scoreboard.commandsRejected()); });
+
+    ImageCache imageCache;
+    WebSocketManager ws(9000, scoreboard, teamManager, base64Coder, imageCache, *frameStreamer, metrics, overlay);
     wsPtr = &ws;
     ws.start();
 
-    ScoreboardRenderer scoreboardRenderer(dfb, resourceLocator, scoreboard.getState());
-    GoalCelebrationRenderer goalRenderer(dfb, resourceLocator, scoreboard);
+    std::unique_ptr<HttpEndpoint> http;
+    if (args.httpPort() > 0) {
+        http = std::make_unique<HttpEndpoint>(args.httpPort());
+        http->route("/metrics", [&metrics](const ix::HttpRequestPtr&) {
+            return HttpEndpoint::respond(200, "OK", "text/plain; version=0.0.4", metrics.toPrometheus());
+        });
+        // /images/<sha256>, with the hash from a player's imageHash in the teams list. The
+        // URL can only ever name these bytes, so clients may cache them forever.
+        http->route("/images/", [&imageCache](const ix::HttpRequestPtr& request) {
+            std::string path = request->uri.substr(0, request->uri.find('?'));
+            std::string hash = path.substr(std::string("/images/").size());
+            hash = hash.substr(0, hash.find('.')); // Allow an extension for the client's benefit
+            const ImageCache::Image image = imageCache.find(hash);
+            if (image.sha256.empty()) {
+                return HttpEndpoint::respond(404, "Not Found", "text/plain", "Unknown image\n");
+            }
+            return HttpEndpoint::respondImmutable(request, image.sha256, image.contentType, *image.bytes);
+        });
+        if (Tracer::enabled()) {
+            http->route("/trace", [](const ix::HttpRequestPtr&) {
+                std::ostringstream trace;
+                Tracer::writeChromeJson(trace);
+                return HttpEndpoint::respond(200, "OK", "application/json", trace.str());
+            });
+        }
+        http->start();
+    }
+
+    ScoreboardRenderer scoreboardRenderer(dfb, resourceLocator);
+    GoalCelebrationRenderer goalRenderer(dfb, resourceLocator);
 
 #ifdef ENABLE_SFML
-    KeyboardControl simulator(scoreboard);
+    KeyboardControl simulator(scoreboard, overlay);
 #endif
 
     NetworkManager network(9000);
@@ -122,6 +347,26 @@ int main(int argc, char* argv[]) {
 
     std::signal(SIGINT, signalHandler);
     std::signal(SIGTERM, signalHandler);
+    std::signal(SIGUSR1, jitterSignalHandler);
+    std::signal(SIGUSR2, traceSignalHandler);
+
+    // Realtime mode only affects this thread (render + output). The WebSocket and mDNS
+    // threads were started above and keep the normal scheduling policy.
+    if (args.cpu() >= 0) {
+        pinCurrentThreadToCpu(args.cpu());
+    }
+    if (args.enableRealtime()) {
+        lockProcessMemory();
+        if (setRealtimePriority(args.realtimePriority())) {
+            std::cout << "Realtime mode: SCHED_FIFO priority " << args.realtimePriority() << std::endl;
+        }
+    }
+
+    // The loop runs on fixed 10ms ticks. Sleeping until an absolute deadline (rather than
+    // for 10ms after the work) keeps the tick from drifting with render and output time.
+    constexpr auto tickPeriod = std::chrono::milliseconds(10);
+    auto tickDeadline = std::chrono::steady_clock::now();
+    JitterHistogram sendJitter;
 
     // Main application loop
     while(g_running) {
@@ -138,38 +383,93 @@ int main(int argc, char* argv[]) {
         if (!g_running) break;
 
         // --- LOGIC ---
-        scoreboard.update();
+        {
+            TRACE_SCOPE("main", "update");
+            AllocationScope allocations(AllocationSubsystem::Update);
+            ScopedLatency timer(updateTime);
+            scoreboard.update();
+        }
 
-        // --- RENDER (Only if dirty) ---
-        if (scoreboard.isDirty()) {
-            if (scoreboard.getState().goalEvent.active) {
-                goalRenderer.render();
-            } else {
-                scoreboardRenderer.render();
+        // --- RENDER (Only if dirty, or the diagnostic overlay is due for new numbers) ---
+        const auto frameStart = std::chrono::steady_clock::now();
+        if (scoreboard.isDirty() || overlay.needsFrame(frameStart)) {
+            {
+                TRACE_SCOPE("main", "render");
+                AllocationScope allocations(AllocationSubsystem::Render);
+                ScopedLatency timer(renderTime);
+                // The frame is drawn from one consistent, versioned copy of the state
+                const ScoreboardSnapshotPtr frame = scoreboard.snapshot();
+                if (frame->state.goalEvent.active) {
+                    goalRenderer.render(*frame);
+                } else {
+                    scoreboardRenderer.render(*frame);
+                }
+                overlay.compose(frameStart);
             }
 
             // --- DISPLAY ---
-            dfb.swap();
+            {
+                TRACE_SCOPE("main", "swap");
+                ScopedLatency timer(swapTime);
+                dfb.swap();
+            }
 
-            for (IDisplay* disp : displays) {
-                disp->output();
+            sendJitter.record(std::chrono::steady_clock::now() - tickDeadline);
+
+            for (size_t i = 0; i < displays.size(); ++i) {
+                TRACE_SCOPE("display", displays[i]->name());
+                AllocationScope allocations(AllocationSubsystem::Display);
+                ScopedLatency timer(*outputTimes[i]);
+                displays[i]->output();
             }
 
+            framesRendered.add();
             scoreboard.clearDirty();
         }
 
+        if (g_printJitter.exchange(false)) {
+            sendJitter.print(std::cout, "Frame send lateness vs. tick deadline");
+        }
+
+        // Writing a full trace takes a while; keep it off the render thread, and off its
+        // realtime priority and core, which a new thread would otherwise inherit
+        if (g_dumpTrace.exchange(false) && Tracer::enabled()) {
+            std::thread([] {
+                resetThreadScheduling();
+                dumpTrace();
+            }).detach();
+        }
+
         // Avoid pegged CPU
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        tickDeadline += tickPeriod;
+        auto now = std::chrono::steady_clock::now();
+        if (now - tickDeadline > tickPeriod) {
+            ticksMissed.add((now - tickDeadline) / tickPeriod);
+            tickDeadline = now; // We fell more than a tick behind; don't try to catch up
+        }
+        std::this_thread::sleep_until(tickDeadline);
+    }
+
+    if (args.reportJitter()) {
+        sendJitter.print(std::cout, "Frame send lateness vs. tick deadline");
+    }
+
+    if (Tracer::enabled()) {
+        dumpTrace();
     }
 
     std::cout << "Shutting down..." << std::endl;
     network.stop();
     ws.stop();
+    if (http) {
+        http->stop();
+    }
 
     for (IDisplay* disp : displays) {
         delete disp;
     }
     displays.clear();
 
+    Log::stop();
     return 0;
 }
@@ -1,40 +1,361 @@
 #include "Base64Coder.h"
+#include <array>
 
-static const std::string base64_chars =
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BASE64_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define BASE64_NEON 1
+#include <arm_neon.h>
+#endif
+
+using Kernel = Base64Coder::Kernel;
+
+static constexpr char ALPHABET[] =
     "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
     "abcdefghijklmnopqrstuvwxyz"
     "0123456789+/";
 
-std::string Base64Coder::encode(const std::vector<uint8_t>& in) const {
-    std::string out;
-    int val = 0, valb = -6;
-    for (uint8_t c : in) {
-        val = (val << 8) + c;
-        valb += 8;
-        while (valb >= 0) {
-            out.push_back(base64_chars[(val >> valb) & 0x3F]);
-            valb -= 6;
+static constexpr uint8_t INVALID = 0xFF;
+
+// Character -> 6-bit value, INVALID for everything outside the alphabet (including '=')
+static constexpr std::array<uint8_t, 256> DECODE_TABLE = [] {
+    std::array<uint8_t, 256> table{};
+    table.fill(INVALID);
+    for (uint8_t i = 0; i < 64; ++i) table[static_cast<uint8_t>(ALPHABET[i])] = i;
+    return table;
+}();
+
+// --- Scalar ---
+
+static void encodeScalar(const uint8_t*& src, const uint8_t* end, char*& dst) {
+    for (; end - src >= 3; src += 3, dst += 4) {
+        const uint32_t value = uint32_t{src[0]} << 16 | uint32_t{src[1]} << 8 | src[2];
+        dst[0] = ALPHABET[value >> 18];
+        dst[1] = ALPHABET[(value >> 12) & 0x3F];
+        dst[2] = ALPHABET[(value >> 6) & 0x3F];
+        dst[3] = ALPHABET[value & 0x3F];
+    }
+    if (src == end) return;
+
+    const bool two = end - src == 2;
+    const uint32_t value = uint32_t{src[0]} << 16 | (two ? uint32_t{src[1]} << 8 : 0);
+    dst[0] = ALPHABET[value >> 18];
+    dst[1] = ALPHABET[(value >> 12) & 0x3F];
+    dst[2] = two ? ALPHABET[(value >> 6) & 0x3F] : '=';
+    dst[3] = '=';
+    src = end;
+    dst += 4;
+}
+
+// Whole groups of four alphabet characters; stops at the first group with anything else
+static void decodeScalar(const char*& src, const char* end, uint8_t*& dst) {
+    for (; end - src >= 4; src += 4, dst += 3) {
+        const uint8_t a = DECODE_TABLE[static_cast<uint8_t>(src[0])];
+        const uint8_t b = DECODE_TABLE[static_cast<uint8_t>(src[1])];
+        const uint8_t c = DECODE_TABLE[static_cast<uint8_t>(src[2])];
+        const uint8_t d = DECODE_TABLE[static_cast<uint8_t>(src[3])];
+        if ((a | b | c | d) & 0x80) return;
+        const uint32_t value = uint32_t{a} << 18 | uint32_t{b} << 12 | uint32_t{c} << 6 | d;
+        dst[0] = static_cast<uint8_t>(value >> 16);
+        dst[1] = static_cast<uint8_t>(value >> 8);
+        dst[2] = static_cast<uint8_t>(value);
+    }
+}
+
+// The rest, one character at a time, skipping anything outside the alphabet. Always starts
+// on a group boundary, so no bits are carried in.
+static void decodeSkipping(const char* src, const char* end, uint8_t*& dst) {
+    uint32_t value = 0;
+    int bits = -8;
+    for (; src != end; ++src) {
+        const uint8_t sextet = DECODE_TABLE[static_cast<uint8_t>(*src)];
+        if (sextet == INVALID) continue;
+        value = (value << 6 | sextet) & 0xFFFFFF;
+        bits += 6;
+        if (bits >= 0) {
+            *dst++ = static_cast<uint8_t>(value >> bits);
+            bits -= 8;
         }
     }
-    if (valb > -6) out.push_back(base64_chars[((val << 8) >> (valb + 8)) & 0x3F]);
-    while (out.size() % 4) out.push_back('=');
-    return out;
 }
 
-std::vector<uint8_t> Base64Coder::decode(const std::string& in) const {
-    std::vector<uint8_t> out;
-    std::vector<int> T(256, -1);
-    for (int i = 0; i < 64; i++) T[base64_chars[i]] = i;
-
-    int val = 0, valb = -8;
-    for (uint8_t c : in) {
-        if (T[c] == -1) continue;
-        val = (val << 6) + T[c];
-        valb += 6;
-        if (valb >= 0) {
-            out.push_back(uint8_t((val >> valb) & 0xFF));
-            valb -= 8;
+// --- x86 ---
+//
+// The encoders spread each 3 input bytes over four bytes and move the 6-bit fields into
+// place with two multiplies, then map 0-63 to ASCII by adding an offset chosen with a
+// shuffle. The decoders classify every character by its two nibbles to find invalid ones,
+// add a per-range offset to get the 6-bit values, and pack them with two multiply-adds.
+
+#ifdef BASE64_X86
+
+__attribute__((target("ssse3")))
+static __m128i sextetsToAscii(const __m128i sextets) {
+    const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                          '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    // 0-25 -> 13, 26-51 -> 0, 52-61 -> 1-10, 62 -> 11, 63 -> 12
+    __m128i range = _mm_subs_epu8(sextets, _mm_set1_epi8(51));
+    const __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), sextets);
+    range = _mm_or_si128(range, _mm_and_si128(upper, _mm_set1_epi8(13)));
+    return _mm_add_epi8(sextets, _mm_shuffle_epi8(offsets, range));
+}
+
+__attribute__((target("ssse3")))
+static void encodeSsse3(const uint8_t*& src, const uint8_t* end, char*& dst) {
+    const __m128i spread = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    // Reads 16 bytes to use 12
+    for (; end - src >= 16; src += 12, dst += 16) {
+        const __m128i in = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), spread);
+        const __m128i high = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+        const __m128i low = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), sextetsToAscii(_mm_or_si128(high, low)));
+    }
+}
+
+// False if any of the 16 characters is outside the alphabet
+__attribute__((target("ssse3")))
+static bool asciiToSextets(const __m128i in, __m128i& sextets) {
+    const __m128i lowClass = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                           0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i highClass = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i offsets = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+
+    const __m128i lowNibbles = _mm_and_si128(in, _mm_set1_epi8(0x0F));
+    const __m128i highNibbles = _mm_and_si128(_mm_srli_epi32(in, 4), _mm_set1_epi8(0x0F));
+    const __m128i invalid = _mm_and_si128(_mm_shuffle_epi8(lowClass, lowNibbles), _mm_shuffle_epi8(highClass, highNibbles));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(invalid, _mm_setzero_si128())) != 0xFFFF) return false;
+
+    // '/' shares its high nibble with '+' but needs its own offset
+    const __m128i slash = _mm_cmpeq_epi8(in, _mm_set1_epi8('/'));
+    sextets = _mm_add_epi8(in, _mm_shuffle_epi8(offsets, _mm_add_epi8(slash, highNibbles)));
+    return true;
+}
+
+__attribute__((target("ssse3")))
+static __m128i packSextets(const __m128i sextets) {
+    const __m128i pairs = _mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140));
+    const __m128i triples = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(triples, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+__attribute__((target("ssse3")))
+static void decodeSsse3(const char*& src, const char* end, uint8_t*& dst, const uint8_t* dstEnd) {
+    // Writes 16 bytes to produce 12
+    for (; end - src >= 16 && dstEnd - dst >= 16; src += 16, dst += 12) {
+        __m128i sextets;
+        if (!asciiToSextets(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), sextets)) return;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), packSextets(sextets));
+    }
+}
+
+__attribute__((target("avx2")))
+static void encodeAvx2(const uint8_t*& src, const uint8_t* end, char*& dst) {
+    const __m256i spread = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                            1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i offsets = _mm256_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    // 24 bytes per iteration, 12 per lane; the second lane's load reads 4 bytes past them
+    for (; end - src >= 28; src += 24, dst += 32) {
+        __m256i in = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 12)), 1);
+        in = _mm256_shuffle_epi8(in, spread);
+        const __m256i high = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+        const __m256i low = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+        const __m256i sextets = _mm256_or_si256(high, low);
+
+        __m256i range = _mm256_subs_epu8(sextets, _mm256_set1_epi8(51));
+        const __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), sextets);
+        range = _mm256_or_si256(range, _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+        const __m256i ascii = _mm256_add_epi8(sextets, _mm256_shuffle_epi8(offsets, range));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), ascii);
+    }
+}
+
+__attribute__((target("avx2")))
+static void decodeAvx2(const char*& src, const char* end, uint8_t*& dst, const uint8_t* dstEnd) {
+    const __m256i lowClass = _mm256_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i highClass = _mm256_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i offsets = _mm256_setr_epi8(
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i pack = _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i lanesTogether = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+
+    // Writes 32 bytes to produce 24
+    for (; end - src >= 32 && dstEnd - dst >= 32; src += 32, dst += 24) {
+        const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        const __m256i lowNibbles = _mm256_and_si256(in, _mm256_set1_epi8(0x0F));
+        const __m256i highNibbles = _mm256_and_si256(_mm256_srli_epi32(in, 4), _mm256_set1_epi8(0x0F));
+        if (!_mm256_testz_si256(_mm256_shuffle_epi8(lowClass, lowNibbles), _mm256_shuffle_epi8(highClass, highNibbles))) return;
+
+        const __m256i slash = _mm256_cmpeq_epi8(in, _mm256_set1_epi8('/'));
+        const __m256i sextets = _mm256_add_epi8(in, _mm256_shuffle_epi8(offsets, _mm256_add_epi8(slash, highNibbles)));
+        const __m256i pairs = _mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140));
+        const __m256i triples = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+        const __m256i packed = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(triples, pack), lanesTogether);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), packed);
+    }
+}
+
+#endif
+
+// --- ARM ---
+//
+// Interleaving loads and stores (vld3/vst4 to encode, vld4/vst3 to decode) split the data
+// into one register per position in a group, so the bit moves are plain shifts and the
+// alphabet mappings are table lookups.
+
+#ifdef BASE64_NEON
+
+static uint8x16x4_t loadTable(const uint8_t* table) {
+    uint8x16x4_t registers;
+    for (int i = 0; i < 4; ++i) registers.val[i] = vld1q_u8(table + i * 16);
+    return registers;
+}
+
+static void encodeNeon(const uint8_t*& src, const uint8_t* end, char*& dst) {
+    const uint8x16x4_t alphabet = loadTable(reinterpret_cast<const uint8_t*>(ALPHABET));
+    const uint8x16_t mask = vdupq_n_u8(0x3F);
+    for (; end - src >= 48; src += 48, dst += 64) {
+        const uint8x16x3_t in = vld3q_u8(src);
+        uint8x16x4_t out;
+        out.val[0] = vshrq_n_u8(in.val[0], 2);
+        out.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), mask);
+        out.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), mask);
+        out.val[3] = vandq_u8(in.val[2], mask);
+        for (int i = 0; i < 4; ++i) out.val[i] = vqtbl4q_u8(alphabet, out.val[i]);
+        vst4q_u8(reinterpret_cast<uint8_t*>(dst), out);
+    }
+}
+
+static void decodeNeon(const char*& src, const char* end, uint8_t*& dst, const uint8_t*) {
+    // Characters 0-63 are looked up in the first table and 64-127 in the second; anything
+    // from 128 up misses both and is caught by its own top bit
+    const uint8x16x4_t low = loadTable(DECODE_TABLE.data());
+    const uint8x16x4_t high = loadTable(DECODE_TABLE.data() + 64);
+    const uint8x16_t sixtyFour = vdupq_n_u8(64);
+    for (; end - src >= 64; src += 64, dst += 48) {
+        const uint8x16x4_t in = vld4q_u8(reinterpret_cast<const uint8_t*>(src));
+        uint8x16x4_t sextets;
+        uint8x16_t invalid = vdupq_n_u8(0);
+        for (int i = 0; i < 4; ++i) {
+            sextets.val[i] = vqtbx4q_u8(vqtbl4q_u8(low, in.val[i]), high, vsubq_u8(in.val[i], sixtyFour));
+            invalid = vorrq_u8(invalid, vorrq_u8(sextets.val[i], in.val[i]));
+        }
+        if (vmaxvq_u8(invalid) & 0x80) return;
+
+        uint8x16x3_t out;
+        out.val[0] = vorrq_u8(vshlq_n_u8(sextets.val[0], 2), vshrq_n_u8(sextets.val[1], 4));
+        out.val[1] = vorrq_u8(vshlq_n_u8(sextets.val[1], 4), vshrq_n_u8(sextets.val[2], 2));
+        out.val[2] = vorrq_u8(vshlq_n_u8(sextets.val[2], 6), sextets.val[3]);
+        vst3q_u8(dst, out);
+    }
+}
+
+#endif
+
+// --- Dispatch ---
+
+bool Base64Coder::kernelSupported(const Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Scalar: return true;
+#ifdef BASE64_X86
+        case Kernel::Ssse3: return __builtin_cpu_supports("ssse3");
+        case Kernel::Avx2: return __builtin_cpu_supports("avx2");
+#endif
+#ifdef BASE64_NEON
+        case Kernel::Neon: return true;
+#endif
+        default: return false;
+    }
+}
+
+Kernel Base64Coder::bestKernel() {
+    static const Kernel best = [] {
+        for (const Kernel kernel : {Kernel::Avx2, Kernel::Neon, Kernel::Ssse3}) {
+            if (kernelSupported(kernel)) return kernel;
+        }
+        return Kernel::Scalar;
+    }();
+    return best;
+}
+
+const char* Base64Coder::kernelName(const Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Ssse3: return "ssse3";
+        case Kernel::Avx2: return "avx2";
+        case Kernel::Neon: return "neon";
+        default: return "scalar";
+    }
+}
+
+size_t Base64Coder::decodedSize(const std::string_view base64) {
+    size_t length = base64.size();
+    for (int i = 0; i < 2 && length > 0 && base64[length - 1] == '='; ++i) length--;
+    return length / 4 * 3 + (length % 4) * 3 / 4;
+}
+
+void Base64Coder::encodeInto(const uint8_t* data, const size_t size, char* out, const Kernel kernel) {
+    const uint8_t* src = data;
+    const uint8_t* end = data + size;
+    if (kernelSupported(kernel)) {
+        switch (kernel) {
+#ifdef BASE64_X86
+            case Kernel::Avx2: encodeAvx2(src, end, out); break;
+            case Kernel::Ssse3: encodeSsse3(src, end, out); break;
+#endif
+#ifdef BASE64_NEON
+            case Kernel::Neon: encodeNeon(src, end, out); break;
+#endif
+            default: break;
         }
     }
+    encodeScalar(src, end, out);
+}
+
+size_t Base64Coder::decodeInto(const std::string_view base64, uint8_t* out, const Kernel kernel) {
+    const char* src = base64.data();
+    const char* end = src + base64.size();
+    uint8_t* dst = out;
+    const uint8_t* dstEnd = out + decodedSize(base64);
+    if (kernelSupported(kernel)) {
+        switch (kernel) {
+#ifdef BASE64_X86
+            case Kernel::Avx2: decodeAvx2(src, end, dst, dstEnd); break;
+            case Kernel::Ssse3: decodeSsse3(src, end, dst, dstEnd); break;
+#endif
+#ifdef BASE64_NEON
+            case Kernel::Neon: decodeNeon(src, end, dst, dstEnd); break;
+#endif
+            default: break;
+        }
+    }
+    // The vector loops stop at a block with padding or anything else outside the alphabet;
+    // take whole groups from there while they're clean, then go character by character
+    decodeScalar(src, end, dst);
+    decodeSkipping(src, end, dst);
+    return static_cast<size_t>(dst - out);
+}
+
+std::string Base64Coder::encode(const std::vector<uint8_t>& in) const {
+    std::string out(encodedSize(in.size()), '\0');
+    encodeInto(in.data(), in.size(), out.data());
+    return out;
+}
+
+std::vector<uint8_t> Base64Coder::decode(const std::string& in) const {
+    std::vector<uint8_t> out(decodedSize(in));
+    out.resize(decodeInto(in, out.data()));
     return out;
 }
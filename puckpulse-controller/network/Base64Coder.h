@@ -1,12 +1,37 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 
+// Standard base64 with '=' padding. Work is done in blocks by the fastest kernel the CPU
+// has (AVX2 or SSSE3, chosen at runtime on x86; NEON on 64-bit ARM), with a scalar loop for
+// the tail and for machines without either. Decoding skips characters outside the alphabet
+// (line breaks, padding) like the original scalar decoder did; input without any takes the
+// vector path throughout.
 class Base64Coder {
 public:
+    enum class Kernel { Scalar, Ssse3, Avx2, Neon };
+
     virtual ~Base64Coder() = default;
     virtual std::string encode(const std::vector<uint8_t>& data) const;
     virtual std::vector<uint8_t> decode(const std::string& base64) const;
+
+    // Exact length of the encoding of `size` bytes, padding included
+    static constexpr size_t encodedSize(const size_t size) { return (size + 2) / 3 * 4; }
+    // Exact for canonical base64; an upper bound when it contains characters that are skipped
+    static size_t decodedSize(std::string_view base64);
+
+    // Writes encodedSize(size) characters to out
+    static void encodeInto(const uint8_t* data, size_t size, char* out, Kernel kernel = bestKernel());
+    // Writes at most decodedSize(base64) bytes to out and returns how many
+    static size_t decodeInto(std::string_view base64, uint8_t* out, Kernel kernel = bestKernel());
+
+    // The fastest kernel this machine supports, detected once
+    static Kernel bestKernel();
+    // An unsupported kernel passed to encodeInto()/decodeInto() runs as Scalar
+    static bool kernelSupported(Kernel kernel);
+    static const char* kernelName(Kernel kernel);
 };
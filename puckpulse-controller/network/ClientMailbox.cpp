@@ -0,0 +1,82 @@
+#include "ClientMailbox.h"
+
+bool ClientMailbox::postState(Message message) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const bool replaced = state.has_value();
+    if (replaced) statesReplaced++;
+    state = std::move(message);
+    return replaced;
+}
+
+// The newest message is always kept, even when it alone is over the limit; a client
+// asking for one large image should still get it.
+size_t ClientMailbox::post(Message message) {
+    std::lock_guard<std::mutex> lock(mutex);
+    queuedBytes += message.payload->size();
+    queue.push_back(std::move(message));
+
+    size_t dropped = 0;
+    while (queuedBytes > maxQueuedBytes && queue.size() > 1) {
+        queuedBytes -= queue.front().payload->size();
+        queue.pop_front();
+        dropped++;
+    }
+    messagesDropped += dropped;
+    return dropped;
+}
+
+void ClientMailbox::postStream(std::shared_ptr<Stream> stream) {
+    std::lock_guard<std::mutex> lock(mutex);
+    streams.push_back(std::move(stream));
+}
+
+bool ClientMailbox::statePending() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return state.has_value();
+}
+
+bool ClientMailbox::empty() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return !state && queue.empty() && streams.empty();
+}
+
+// A stream reads outside the lock so posting never waits on its disk I/O. Only the sender
+// thread takes, so the front stream can't be taken by anyone else meanwhile.
+std::optional<ClientMailbox::Message> ClientMailbox::take() {
+    while (true) {
+        std::shared_ptr<Stream> stream;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (state) {
+                std::optional<Message> message = std::move(state);
+                state.reset();
+                return message;
+            }
+            if (!queue.empty()) {
+                std::optional<Message> message = std::move(queue.front());
+                queue.pop_front();
+                queuedBytes -= message->payload->size();
+                return message;
+            }
+            if (streams.empty()) return std::nullopt;
+            stream = streams.front();
+        }
+
+        std::optional<Message> message = stream->next();
+        if (message) return message;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!streams.empty() && streams.front() == stream) streams.pop_front();
+    }
+}
+
+ClientMailbox::Stats ClientMailbox::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats s;
+    s.queuedMessages = queue.size() + (state ? 1 : 0);
+    s.queuedBytes = queuedBytes + (state ? state->payload->size() : 0);
+    s.streams = streams.size();
+    s.statesReplaced = statesReplaced;
+    s.messagesDropped = messagesDropped;
+    return s;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include "../Metrics.h"
+
+// Outbound messages for one WebSocket client, waiting for its socket to drain.
+//
+// Scoreboard states are latest-wins: there is one slot, and a newer state replaces one
+// that hasn't gone out yet, so a client on a bad link skips to the current score
+// instead of replaying every change it missed. Everything else (rosters, images, command
+// replies) is queued in order up to a byte limit; past it the oldest messages are dropped.
+// Payloads are shared, so a broadcast costs one encode however many clients take it.
+// Streams (image downloads) come last and are read one message at a time as the socket
+// drains, so a large transfer never sits in memory or crowds out the score.
+//
+// Any thread posts; the WebSocketManager sender thread takes.
+class ClientMailbox {
+public:
+    struct Message {
+        std::shared_ptr<const std::string> payload;
+        bool binary = false;
+        Counter* sentBytes = nullptr; // Added to once the message is handed to the socket
+    };
+
+    // Produces the messages of one transfer on demand. Only the sender thread calls next().
+    class Stream {
+    public:
+        virtual ~Stream() = default;
+        // The next message, or nullopt when the stream is finished
+        virtual std::optional<Message> next() = 0;
+    };
+
+    struct Stats {
+        size_t queuedMessages = 0; // Including a pending state
+        size_t queuedBytes = 0;
+        size_t streams = 0;
+        uint64_t statesReplaced = 0;
+        uint64_t messagesDropped = 0;
+    };
+
+    explicit ClientMailbox(size_t maxQueuedBytes) : maxQueuedBytes(maxQueuedBytes) {}
+
+    // Returns true when it replaced a state that hadn't been sent
+    bool postState(Message message);
+    // Returns the number of older messages dropped to make room
+    size_t post(Message message);
+    void postStream(std::shared_ptr<Stream> stream);
+
+    [[nodiscard]] bool statePending() const;
+    [[nodiscard]] bool empty() const;
+    // The next message to send: the pending state, then queued messages, then streams in
+    // the order they were posted
+    std::optional<Message> take();
+
+    [[nodiscard]] Stats stats() const;
+
+private:
+    const size_t maxQueuedBytes;
+
+    mutable std::mutex mutex;
+    std::optional<Message> state;
+    std::deque<Message> queue;
+    std::deque<std::shared_ptr<Stream>> streams;
+    size_t queuedBytes = 0; // Of `queue` only
+    uint64_t statesReplaced = 0;
+    uint64_t messagesDropped = 0;
+};
@@ -0,0 +1,38 @@
+#include "CommandTable.h"
+#include <stdexcept>
+#include <string>
+
+using json = nlohmann::json;
+
+static ClockMode parseClockMode(const std::string& mode) {
+    if (mode == "Game") return ClockMode::Game;
+    if (mode == "Intermission") return ClockMode::Intermission;
+    if (mode == "TimeOfDay") return ClockMode::TimeOfDay;
+    throw std::invalid_argument("unknown clock mode: " + mode);
+}
+
+ScoreboardCommand parseScoreboardCommand(const CommandId id, const json& j) {
+    switch (id) {
+        case CommandId::SetHomeScore: return commands::SetHomeScore{j.at("value").get<int>()};
+        case CommandId::SetAwayScore: return commands::SetAwayScore{j.at("value").get<int>()};
+        case CommandId::AddHomeScore: return commands::AddHomeScore{j.value("delta", 1)};
+        case CommandId::AddAwayScore: return commands::AddAwayScore{j.value("delta", 1)};
+        case CommandId::AddHomeShots: return commands::AddHomeShots{j.value("delta", 1)};
+        case CommandId::AddAwayShots: return commands::AddAwayShots{j.value("delta", 1)};
+        case CommandId::SetHomeTeamName: return commands::SetHomeTeamName{j.at("value").get<std::string>()};
+        case CommandId::SetAwayTeamName: return commands::SetAwayTeamName{j.at("value").get<std::string>()};
+        case CommandId::SetHomePenalty:
+            return commands::SetHomePenalty{j.at("index").get<int>(), j.at("value").get<int>(), j.at("player").get<int>()};
+        case CommandId::SetAwayPenalty:
+            return commands::SetAwayPenalty{j.at("index").get<int>(), j.at("value").get<int>(), j.at("player").get<int>()};
+        case CommandId::AddHomePenalty: return commands::AddHomePenalty{j.at("value").get<int>(), j.value("player", 0)};
+        case CommandId::AddAwayPenalty: return commands::AddAwayPenalty{j.at("value").get<int>(), j.value("player", 0)};
+        case CommandId::ToggleClock: return commands::ToggleClock{};
+        case CommandId::ResetGame: return commands::ResetGame{};
+        case CommandId::NextPeriod: return commands::NextPeriod{};
+        case CommandId::SetTime: return commands::SetTime{j.at("minutes").get<int>(), j.at("seconds").get<int>()};
+        case CommandId::SetClockMode: return commands::SetClockMode{parseClockMode(j.at("value").get<std::string>())};
+        default: break;
+    }
+    throw std::invalid_argument(std::string("not a scoreboard command: ") + commandName(id));
+}
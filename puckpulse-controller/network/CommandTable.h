@@ -0,0 +1,117 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <nlohmann/json.hpp>
+#include "../ScoreboardCommand.h"
+
+// Every WebSocket command the server knows, and the name -> id lookup used once per
+// message. The order of CommandId and COMMAND_NAMES must match.
+enum class CommandId : uint8_t {
+    // Connection, roster and diagnostics; handled by WebSocketManager itself
+    Hello, GetState, GetTeams, UploadPlayerImage, GetImage, UploadImage, DownloadImage, TriggerGoal,
+    Subscribe, Unsubscribe, SubscribeFrames, UnsubscribeFrames, GetStats, SetDiagnosticOverlay,
+    AddOrUpdatePlayer, RemovePlayer, DeleteTeam,
+    // Scoreboard mutations; parseScoreboardCommand() turns them into a ScoreboardCommand
+    SetHomeScore, SetAwayScore, AddHomeScore, AddAwayScore, AddHomeShots, AddAwayShots,
+    SetHomeTeamName, SetAwayTeamName, SetHomePenalty, SetAwayPenalty, AddHomePenalty, AddAwayPenalty,
+    ToggleClock, ResetGame, NextPeriod, SetTime, SetClockMode,
+    Unknown,
+};
+
+inline constexpr size_t COMMAND_COUNT = static_cast<size_t>(CommandId::Unknown);
+
+inline constexpr std::array<std::string_view, COMMAND_COUNT + 1> COMMAND_NAMES = {
+    "hello", "getState", "getTeams", "uploadPlayerImage", "getImage", "uploadImage", "downloadImage", "triggerGoal",
+    "subscribe", "unsubscribe", "subscribeFrames", "unsubscribeFrames", "getStats", "setDiagnosticOverlay",
+    "addOrUpdatePlayer", "removePlayer", "deleteTeam",
+    "setHomeScore", "setAwayScore", "addHomeScore", "addAwayScore", "addHomeShots", "addAwayShots",
+    "setHomeTeamName", "setAwayTeamName", "setHomePenalty", "setAwayPenalty", "addHomePenalty", "addAwayPenalty",
+    "toggleClock", "resetGame", "nextPeriod", "setTime", "setClockMode",
+    "unknown",
+};
+
+constexpr const char* commandName(const CommandId id) {
+    return COMMAND_NAMES[static_cast<size_t>(id)].data();
+}
+
+constexpr bool isScoreboardCommand(const CommandId id) {
+    return id >= CommandId::SetHomeScore && id < CommandId::Unknown;
+}
+
+// --- Perfect hash ---
+//
+// Names are hashed with FNV-1a, and the slot is the top 7 bits of the hash times an odd
+// multiplier. The multiplier is searched at compile time so that every name lands in its
+// own slot of the 128-entry table. A lookup is one hash, one table read and one string
+// compare (to reject names that aren't commands) instead of comparing against every name.
+
+namespace command_table {
+
+inline constexpr int SLOT_BITS = 7;
+inline constexpr size_t SLOT_COUNT = size_t{1} << SLOT_BITS;
+inline constexpr uint8_t EMPTY_SLOT = 0xFF;
+
+constexpr uint32_t hashName(const std::string_view name) {
+    uint32_t hash = 2166136261u;
+    for (const char c : name) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+constexpr size_t slotFor(const uint32_t hash, const uint32_t multiplier) {
+    return (hash * multiplier) >> (32 - SLOT_BITS);
+}
+
+struct PerfectHash {
+    uint32_t multiplier = 0;
+    std::array<uint8_t, SLOT_COUNT> slots{}; // CommandId per slot, or EMPTY_SLOT
+    bool found = false;
+};
+
+constexpr PerfectHash buildPerfectHash() {
+    for (uint32_t multiplier = 1; multiplier < 200000; multiplier += 2) {
+        PerfectHash table;
+        table.multiplier = multiplier;
+        table.slots.fill(EMPTY_SLOT);
+        bool collision = false;
+        for (size_t i = 0; i < COMMAND_COUNT && !collision; ++i) {
+            uint8_t& slot = table.slots[slotFor(hashName(COMMAND_NAMES[i]), multiplier)];
+            collision = slot != EMPTY_SLOT;
+            slot = static_cast<uint8_t>(i);
+        }
+        if (!collision) {
+            table.found = true;
+            return table;
+        }
+    }
+    return {};
+}
+
+inline constexpr PerfectHash TABLE = buildPerfectHash();
+static_assert(TABLE.found, "no collision-free multiplier for the command names; grow SLOT_BITS");
+
+}
+
+constexpr CommandId findCommand(const std::string_view name) {
+    using namespace command_table;
+    const uint8_t index = TABLE.slots[slotFor(hashName(name), TABLE.multiplier)];
+    if (index == EMPTY_SLOT || COMMAND_NAMES[index] != name) return CommandId::Unknown;
+    return static_cast<CommandId>(index);
+}
+
+static_assert([] {
+    for (size_t i = 0; i < COMMAND_COUNT; ++i) {
+        if (findCommand(COMMAND_NAMES[i]) != static_cast<CommandId>(i)) return false;
+    }
+    return findCommand("") == CommandId::Unknown && findCommand("unknown") == CommandId::Unknown;
+}(), "COMMAND_NAMES out of step with CommandId");
+
+// Builds the typed command for a scoreboard mutation (isScoreboardCommand(id)) from the
+// already-parsed message. Throws like json::at() on missing or mistyped fields, and
+// std::invalid_argument on an unknown clock mode.
+ScoreboardCommand parseScoreboardCommand(CommandId id, const nlohmann::json& j);
@@ -0,0 +1,232 @@
+#include "FrameStreamer.h"
+#include "../display/FrameSource.h"
+#include "../display/PixelConversion.h"
+#include "../Tracer.h"
+#include "../Log.h"
+#include <algorithm>
+#include <cstring>
+
+static void putU16(std::string& out, const uint16_t value) {
+    out.push_back(static_cast<char>(value & 0xFF));
+    out.push_back(static_cast<char>(value >> 8));
+}
+
+static void putU32(std::string& out, const uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+}
+
+FrameStreamer::FrameStreamer(const FrameSource& source)
+    : IDisplay(source), width(source.getWidth()), height(source.getHeight()) {
+    incoming.resize(static_cast<size_t>(width) * height * 4);
+    current.resize(static_cast<size_t>(width) * height * 3);
+    streamThread = std::thread(&FrameStreamer::streamLoop, this);
+}
+
+FrameStreamer::~FrameStreamer() {
+    {
+        std::lock_guard<std::mutex> lock(frameMutex);
+        stopping = true;
+    }
+    frameReady.notify_one();
+    if (streamThread.joinable()) {
+        streamThread.join();
+    }
+}
+
+void FrameStreamer::output() {
+    // Always keep the latest frame (a plain copy) so a new subscriber gets the board as it
+    // is now, not whenever it next changes; the encoder only wakes up for subscribers.
+    {
+        std::lock_guard<std::mutex> lock(frameMutex);
+        memcpy(incoming.data(), source.getFrontData(), incoming.size());
+        incomingFrame++;
+    }
+    if (subscriberCount.load(std::memory_order_relaxed) > 0) {
+        frameReady.notify_one();
+    }
+}
+
+void FrameStreamer::subscribe(const std::string& clientId, std::weak_ptr<ix::WebSocket> socket, int maxFps) {
+    maxFps = std::clamp(maxFps, 1, MAX_FPS);
+    {
+        std::lock_guard<std::mutex> lock(subscribersMutex);
+        Subscriber& subscriber = subscribers[clientId];
+        subscriber.socket = std::move(socket);
+        subscriber.interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::seconds(1)) / maxFps;
+        subscriber.nextDue = {};
+        subscriber.sentFrame = 0;
+        subscriber.shown.clear(); // (Re)subscribing always starts with a keyframe
+        subscriberCount = static_cast<int>(subscribers.size());
+    }
+    {
+        std::lock_guard<std::mutex> lock(frameMutex);
+        wakeRequested = true;
+    }
+    frameReady.notify_one();
+    LOG_INFO("stream", "Client subscribed to frames", "client", clientId, "maxFps", maxFps);
+}
+
+void FrameStreamer::unsubscribe(const std::string& clientId) {
+    std::lock_guard<std::mutex> lock(subscribersMutex);
+    if (subscribers.erase(clientId) > 0) {
+        LOG_INFO("stream", "Client unsubscribed from frames", "client", clientId);
+    }
+    subscriberCount = static_cast<int>(subscribers.size());
+}
+
+void FrameStreamer::streamLoop() {
+    uint64_t frame = 0;
+    if (Tracer::enabled()) Tracer::setThreadName("preview-stream");
+    auto nextWake = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(frameMutex);
+            frameReady.wait_until(lock, nextWake, [&] {
+                return stopping || wakeRequested || incomingFrame != frame;
+            });
+            if (stopping) break;
+            wakeRequested = false;
+            if (incomingFrame != frame) {
+                TRACE_SCOPE("stream", "pack");
+                packPixels(incoming.data(), current.data(), width * height, ChannelOrder::RGB);
+                frame = incomingFrame;
+            }
+        }
+        nextWake = sendDueFrames(frame);
+    }
+}
+
+std::chrono::steady_clock::time_point FrameStreamer::sendDueFrames(const uint64_t frame) {
+    const auto now = std::chrono::steady_clock::now();
+    auto nextWake = now + std::chrono::seconds(1);
+    if (frame == 0) return nextWake;
+
+    std::lock_guard<std::mutex> lock(subscribersMutex);
+    for (auto it = subscribers.begin(); it != subscribers.end();) {
+        Subscriber& subscriber = it->second;
+        auto socket = subscriber.socket.lock();
+        if (!socket) {
+            it = subscribers.erase(it); // Connection went away without unsubscribing
+            continue;
+        }
+        ++it;
+
+        if (subscriber.sentFrame == frame) continue;
+
+        // Rate limited or backed up: leave the frame pending and come back for it
+        if (now < subscriber.nextDue) {
+            nextWake = std::min(nextWake, subscriber.nextDue);
+            continue;
+        }
+        if (socket->bufferedAmount() > MAX_BUFFERED_BYTES) {
+            nextWake = std::min(nextWake, now + subscriber.interval);
+            continue;
+        }
+
+        TRACE_SCOPE("stream", "send");
+        std::string message = encode(subscriber, frame);
+        subscriber.sentFrame = frame;
+        if (!message.empty()) {
+            socket->sendBinary(message);
+            countSent(1, message.size());
+            subscriber.nextDue = now + subscriber.interval;
+        }
+    }
+    subscriberCount = static_cast<int>(subscribers.size());
+    return nextWake;
+}
+
+void FrameStreamer::findChangedRects(const std::vector<uint8_t>& shown) {
+    rects.clear();
+    const size_t rowBytes = static_cast<size_t>(width) * 3;
+
+    // Consecutive changed rows are merged into one rect spanning their changed columns
+    Rect open{0, 0, 0, 0};
+    bool isOpen = false;
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* a = current.data() + y * rowBytes;
+        const uint8_t* b = shown.data() + y * rowBytes;
+        if (memcmp(a, b, rowBytes) == 0) {
+            if (isOpen) {
+                rects.push_back(open);
+                isOpen = false;
+            }
+            continue;
+        }
+
+        int first = 0;
+        while (memcmp(a + first * 3, b + first * 3, 3) == 0) first++;
+        int last = width - 1;
+        while (memcmp(a + last * 3, b + last * 3, 3) == 0) last--;
+
+        if (!isOpen) {
+            open = {first, y, last - first + 1, 1};
+            isOpen = true;
+        } else {
+            const int x0 = std::min(open.x, first);
+            const int x1 = std::max(open.x + open.w - 1, last);
+            open = {x0, open.y, x1 - x0 + 1, open.h + 1};
+        }
+    }
+    if (isOpen) {
+        rects.push_back(open);
+    }
+}
+
+std::string FrameStreamer::encode(Subscriber& subscriber, const uint64_t frame) {
+    const size_t rowBytes = static_cast<size_t>(width) * 3;
+    const bool keyframe = subscriber.shown.empty();
+
+    if (keyframe) {
+        rects.assign(1, Rect{0, 0, width, height});
+        subscriber.shown.resize(current.size());
+    } else {
+        findChangedRects(subscriber.shown);
+        if (rects.empty()) return {}; // Re-rendered, but nothing visibly changed
+    }
+
+    std::string out;
+    out.reserve(64 + rects.size() * 16);
+    out.append("PPF1", 4);
+    out.push_back(static_cast<char>(keyframe ? 1 : 0));
+    putU16(out, static_cast<uint16_t>(width));
+    putU16(out, static_cast<uint16_t>(height));
+    putU32(out, static_cast<uint32_t>(frame));
+    putU16(out, static_cast<uint16_t>(rects.size()));
+
+    for (const Rect& rect : rects) {
+        putU16(out, static_cast<uint16_t>(rect.x));
+        putU16(out, static_cast<uint16_t>(rect.y));
+        putU16(out, static_cast<uint16_t>(rect.w));
+        putU16(out, static_cast<uint16_t>(rect.h));
+        const size_t lengthAt = out.size();
+        putU32(out, 0);
+
+        // Board graphics are large flat areas, so runs of identical pixels compress well
+        const size_t dataStart = out.size();
+        for (int y = rect.y; y < rect.y + rect.h; ++y) {
+            const uint8_t* row = current.data() + y * rowBytes + rect.x * 3;
+            int x = 0;
+            while (x < rect.w) {
+                int run = 1;
+                while (x + run < rect.w && run < 255 && memcmp(row + x * 3, row + (x + run) * 3, 3) == 0) {
+                    run++;
+                }
+                out.push_back(static_cast<char>(run));
+                out.append(reinterpret_cast<const char*>(row + x * 3), 3);
+                x += run;
+            }
+            memcpy(subscriber.shown.data() + y * rowBytes + rect.x * 3, row, rect.w * 3);
+        }
+
+        const auto length = static_cast<uint32_t>(out.size() - dataStart);
+        for (int i = 0; i < 4; ++i) {
+            out[lengthAt + i] = static_cast<char>((length >> (i * 8)) & 0xFF);
+        }
+    }
+    return out;
+}
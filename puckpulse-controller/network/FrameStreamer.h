@@ -0,0 +1,83 @@
+#pragma once
+
+#include "../display/IDisplay.h"
+#include <ixwebsocket/IXWebSocket.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Streams the rendered board to WebSocket clients that sent "subscribeFrames".
+//
+// It is fed like any other display, so it sees exactly the frames the LEDs get and adds
+// no rendering work. output() only copies the frame; a background thread encodes and
+// sends it. Every client gets a keyframe first, then deltas against the last frame *it*
+// was sent, so a client can be rate limited (or skipped while its socket is backed up)
+// without ever seeing a broken image.
+//
+// Binary message layout (little-endian):
+//
+//   "PPF1" | uint8 flags (bit 0: keyframe) | uint16 width | uint16 height
+//          | uint32 frame number | uint16 rect count
+//   per rect: uint16 x, y, w, h | uint32 data length | RLE data
+//
+// RLE data covers the rect row by row as runs of [uint8 count (1-255), R, G, B].
+// Pixels outside the rects are unchanged from the previous message.
+class FrameStreamer : public IDisplay {
+public:
+    static constexpr int DEFAULT_MAX_FPS = 10;
+    static constexpr int MAX_FPS = 50;
+
+    explicit FrameStreamer(const FrameSource& source);
+    ~FrameStreamer() override;
+
+    void output() override;
+    [[nodiscard]] const char* name() const override { return "preview-stream"; }
+
+    void subscribe(const std::string& clientId, std::weak_ptr<ix::WebSocket> socket, int maxFps);
+    void unsubscribe(const std::string& clientId);
+
+private:
+    // Skip a client while more than this is still queued on its socket
+    static constexpr size_t MAX_BUFFERED_BYTES = 256 * 1024;
+
+    struct Subscriber {
+        std::weak_ptr<ix::WebSocket> socket;
+        std::chrono::steady_clock::duration interval;
+        std::chrono::steady_clock::time_point nextDue;
+        uint64_t sentFrame = 0;
+        std::vector<uint8_t> shown; // RGB image the client currently has; empty until the keyframe
+    };
+
+    struct Rect {
+        int x, y, w, h;
+    };
+
+    int width, height;
+
+    // --- Handoff from the render loop ---
+    std::mutex frameMutex;
+    std::condition_variable frameReady;
+    std::vector<uint8_t> incoming; // Framebuffer pixels (BGRA)
+    uint64_t incomingFrame = 0;
+    bool wakeRequested = false;
+    bool stopping = false;
+    std::atomic<int> subscriberCount{0};
+
+    // --- Streaming thread state ---
+    std::mutex subscribersMutex;
+    std::unordered_map<std::string, Subscriber> subscribers;
+    std::vector<uint8_t> current; // Latest frame as RGB
+    std::vector<Rect> rects;
+    std::thread streamThread;
+
+    void streamLoop();
+    std::chrono::steady_clock::time_point sendDueFrames(uint64_t frame);
+    std::string encode(Subscriber& subscriber, uint64_t frame);
+    void findChangedRects(const std::vector<uint8_t>& shown);
+};
@@ -0,0 +1,90 @@
+#include "HttpEndpoint.h"
+#include <iostream>
+
+HttpEndpoint::HttpEndpoint(const int port) : port(port), server(port, "0.0.0.0") {
+    server.setOnConnectionCallback([this](ix::HttpRequestPtr request, std::shared_ptr<ix::ConnectionState>) {
+        return handleRequest(request);
+    });
+}
+
+HttpEndpoint::~HttpEndpoint() {
+    stop();
+}
+
+void HttpEndpoint::route(const std::string& pathPrefix, Handler handler) {
+    std::lock_guard<std::mutex> lock(routesMutex);
+    routes.emplace_back(pathPrefix, std::move(handler));
+}
+
+void HttpEndpoint::start() {
+    auto res = server.listen();
+    if (!res.first) {
+        std::cerr << "Error: HTTP server failed to listen on port " << port << ": " << res.second << std::endl;
+        return;
+    }
+    server.start();
+    std::cout << "HTTP server started on port " << port << std::endl;
+}
+
+void HttpEndpoint::stop() {
+    server.stop();
+}
+
+ix::HttpResponsePtr HttpEndpoint::respond(const int status, const std::string& description,
+                                          const std::string& contentType, const std::string& body) {
+    ix::WebSocketHttpHeaders headers;
+    headers["Content-Type"] = contentType;
+    return std::make_shared<ix::HttpResponse>(status, description, ix::HttpErrorCode::Ok, headers, body);
+}
+
+// If-None-Match holds "*" or a comma-separated list of (possibly weak) ETags
+static bool etagMatches(const std::string& ifNoneMatch, const std::string& quotedEtag) {
+    if (ifNoneMatch.find('*') != std::string::npos) return true;
+    return ifNoneMatch.find(quotedEtag) != std::string::npos;
+}
+
+ix::HttpResponsePtr HttpEndpoint::respondImmutable(const ix::HttpRequestPtr& request, const std::string& etag,
+                                                   const std::string& contentType, const std::string& body) {
+    ix::WebSocketHttpHeaders headers;
+    headers["ETag"] = "\"" + etag + "\"";
+    headers["Cache-Control"] = "public, max-age=31536000, immutable";
+
+    auto ifNoneMatch = request->headers.find("If-None-Match");
+    if (ifNoneMatch != request->headers.end() && etagMatches(ifNoneMatch->second, headers["ETag"])) {
+        return std::make_shared<ix::HttpResponse>(304, "Not Modified", ix::HttpErrorCode::Ok, headers, "");
+    }
+    headers["Content-Type"] = contentType;
+    return std::make_shared<ix::HttpResponse>(200, "OK", ix::HttpErrorCode::Ok, headers, body);
+}
+
+ix::HttpResponsePtr HttpEndpoint::handleRequest(const ix::HttpRequestPtr& request) {
+    // Ignore any query string when matching
+    const std::string path = request->uri.substr(0, request->uri.find('?'));
+
+    Handler best;
+    size_t bestLength = 0;
+    {
+        std::lock_guard<std::mutex> lock(routesMutex);
+        for (const auto& [prefix, handler] : routes) {
+            if (path.starts_with(prefix) && prefix.size() >= bestLength) {
+                best = handler;
+                bestLength = prefix.size();
+            }
+        }
+    }
+
+    if (!best) {
+        return respond(404, "Not Found", "text/plain", "Not found\n");
+    }
+    if (request->method != "GET" && request->method != "HEAD") {
+        return respond(405, "Method Not Allowed", "text/plain", "Only GET and HEAD are supported\n");
+    }
+    ix::HttpResponsePtr response = best(request);
+    // HEAD gets the headers GET would, with the length of the body it leaves out (a 304 has
+    // none to report)
+    if (request->method == "HEAD" && response && !response->body.empty()) {
+        response->headers["Content-Length"] = std::to_string(response->body.size());
+        response->body.clear();
+    }
+    return response;
+}
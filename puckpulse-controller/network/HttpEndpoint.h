@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <ixwebsocket/IXHttpServer.h>
+
+// Small plain-HTTP server (ixwebsocket's HttpServer) for things that are a better fit for
+// GET than for a WebSocket message, such as the Prometheus /metrics scrape. Handlers are
+// registered by path prefix; the longest matching prefix wins.
+class HttpEndpoint {
+public:
+    using Handler = std::function<ix::HttpResponsePtr(const ix::HttpRequestPtr& request)>;
+
+    explicit HttpEndpoint(int port);
+    ~HttpEndpoint();
+
+    void route(const std::string& pathPrefix, Handler handler);
+
+    void start();
+    void stop();
+
+    static ix::HttpResponsePtr respond(int status, const std::string& description,
+                                       const std::string& contentType, const std::string& body);
+    // For content whose URL names its hash: a strong ETag and a year-long immutable
+    // Cache-Control, and a bodyless 304 when the request's If-None-Match already has it
+    static ix::HttpResponsePtr respondImmutable(const ix::HttpRequestPtr& request, const std::string& etag,
+                                                const std::string& contentType, const std::string& body);
+
+private:
+    int port;
+    ix::HttpServer server;
+
+    std::mutex routesMutex;
+    std::vector<std::pair<std::string, Handler>> routes;
+
+    ix::HttpResponsePtr handleRequest(const ix::HttpRequestPtr& request);
+};
@@ -0,0 +1,133 @@
+#include "ImageCache.h"
+#include "Sha256.h"
+#include "../Tracer.h"
+#include "../Log.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+const char* ImageCache::contentTypeFor(const fs::path& file) {
+    std::string extension = file.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](const unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    if (extension == ".jpg" || extension == ".jpeg") return "image/jpeg";
+    if (extension == ".png") return "image/png";
+    if (extension == ".webp") return "image/webp";
+    return "application/octet-stream";
+}
+
+ImageCache::Image ImageCache::lookup(const fs::path& file) {
+    std::error_code error;
+    const uintmax_t size = fs::file_size(file, error);
+    if (error) return {};
+    const auto modified = fs::last_write_time(file, error);
+    if (error) return {};
+    const std::string key = file.string();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = byFile.find(key);
+        if (it != byFile.end() && it->second.size == size && it->second.modified == modified && it->second.bytes) {
+            touch(key);
+            return {it->second.sha256, contentTypeFor(file), it->second.bytes};
+        }
+    }
+
+    // Read and hash outside the lock; two threads missing on the same file both do the
+    // work and the second one's result is kept
+    TRACE_SCOPE("images", "cacheLoad");
+    auto bytes = std::make_shared<std::string>(size, '\0');
+    std::ifstream in(file, std::ios::binary);
+    if (!in.read(bytes->data(), static_cast<std::streamsize>(size))) {
+        LOG_WARN("images", "Error reading image", "path", key);
+        return {};
+    }
+    Sha256 hasher;
+    hasher.update(bytes->data(), bytes->size());
+    const std::string sha256 = Sha256::toHex(hasher.finish());
+
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry& entry = byFile[key];
+    if (entry.bytes) cachedBytes -= entry.bytes->size();
+    entry.file = file;
+    entry.size = size;
+    entry.modified = modified;
+    entry.sha256 = sha256;
+    entry.bytes = std::move(bytes);
+    cachedBytes += entry.bytes->size();
+    byHash[sha256] = key;
+    touch(key);
+    evict();
+    return {sha256, contentTypeFor(file), entry.bytes};
+}
+
+std::string ImageCache::hashOf(const fs::path& file) {
+    std::error_code error;
+    const uintmax_t size = fs::file_size(file, error);
+    if (error) return {};
+    const auto modified = fs::last_write_time(file, error);
+    if (error) return {};
+    const std::string key = file.string();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = byFile.find(key);
+        if (it != byFile.end() && it->second.size == size && it->second.modified == modified) return it->second.sha256;
+    }
+
+    TRACE_SCOPE("images", "cacheHash");
+    Sha256::Digest digest{};
+    if (!Sha256::hashFile(file, digest)) {
+        LOG_WARN("images", "Error reading image", "path", key);
+        return {};
+    }
+    const std::string sha256 = Sha256::toHex(digest);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry& entry = byFile[key];
+    if (entry.bytes) {
+        // Changed since it was loaded: drop the stale bytes
+        cachedBytes -= entry.bytes->size();
+        entry.bytes.reset();
+        recent.remove(key);
+    }
+    entry.file = file;
+    entry.size = size;
+    entry.modified = modified;
+    entry.sha256 = sha256;
+    byHash[sha256] = key;
+    return sha256;
+}
+
+ImageCache::Image ImageCache::find(const std::string& sha256) {
+    fs::path file;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto hash = byHash.find(sha256);
+        if (hash == byHash.end()) return {};
+        auto it = byFile.find(hash->second);
+        if (it == byFile.end() || it->second.sha256 != sha256) return {};
+        file = it->second.file;
+    }
+    // Through lookup() so a file changed on disk since is noticed (and reloaded if evicted)
+    Image image = lookup(file);
+    if (image.sha256 != sha256) return {};
+    return image;
+}
+
+void ImageCache::touch(const std::string& key) {
+    recent.remove(key);
+    recent.push_front(key);
+}
+
+void ImageCache::evict() {
+    while (cachedBytes > MAX_CACHED_BYTES && recent.size() > 1) {
+        Entry& entry = byFile[recent.back()];
+        recent.pop_back();
+        cachedBytes -= entry.bytes->size();
+        entry.bytes.reset();
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Player image content by file and by SHA-256, so images can be named by their hash
+// (teams JSON, /images/<sha256> over HTTP, chunked downloads) without re-reading and
+// re-hashing the file each time. An entry is reused while the file's size and mtime are
+// unchanged. Only find() and lookup() load bytes; they are kept for the most recently
+// used images up to MAX_CACHED_BYTES. Hashes are kept for every file seen, so an
+// evicted image is read again on demand. Thread-safe.
+class ImageCache {
+public:
+    static constexpr size_t MAX_CACHED_BYTES = 32 * 1024 * 1024;
+
+    struct Image {
+        std::string sha256; // Lowercase hex
+        std::string contentType;
+        std::shared_ptr<const std::string> bytes;
+    };
+
+    // Hash and bytes of the file; an empty sha256 if it can't be read
+    Image lookup(const std::filesystem::path& file);
+    // Just the hash (empty if the file can't be read). A file seen before is not read again
+    // while its size and mtime are unchanged, even if its bytes were evicted; a new one is
+    // hashed while streaming from disk and its bytes aren't cached.
+    std::string hashOf(const std::filesystem::path& file);
+    // The image with this hash among the files looked up so far; empty sha256 if none
+    Image find(const std::string& sha256);
+
+    static const char* contentTypeFor(const std::filesystem::path& file);
+
+private:
+    struct Entry {
+        std::filesystem::path file;
+        uintmax_t size = 0;
+        std::filesystem::file_time_type modified;
+        std::string sha256;
+        std::shared_ptr<const std::string> bytes; // Null once evicted
+    };
+
+    std::mutex mutex;
+    std::unordered_map<std::string, Entry> byFile;        // Keyed by path
+    std::unordered_map<std::string, std::string> byHash;  // sha256 -> path
+    std::list<std::string> recent;                        // Paths with bytes, most recent first
+    size_t cachedBytes = 0;
+
+    void touch(const std::string& key);
+    void evict();
+};
@@ -0,0 +1,220 @@
+#include "ImageTransfer.h"
+#include "../Tracer.h"
+#include "../Log.h"
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static uint64_t getLittleEndian(const std::string_view bytes, const size_t at, const int width) {
+    uint64_t value = 0;
+    for (int i = width - 1; i >= 0; --i) {
+        value = value << 8 | static_cast<uint8_t>(bytes[at + i]);
+    }
+    return value;
+}
+
+static void putLittleEndian(std::string& out, const uint64_t value, const int width) {
+    for (int i = 0; i < width; ++i) {
+        out.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+}
+
+namespace image_chunk {
+
+bool isChunk(const std::string_view frame) {
+    return frame.substr(0, MAGIC.size()) == MAGIC;
+}
+
+bool parse(const std::string_view frame, uint32_t& transferId, uint64_t& offset, std::string_view& data) {
+    if (frame.size() < HEADER_BYTES || frame.size() - HEADER_BYTES > DATA_BYTES || !isChunk(frame)) return false;
+    transferId = static_cast<uint32_t>(getLittleEndian(frame, 4, 4));
+    offset = getLittleEndian(frame, 8, 8);
+    data = frame.substr(HEADER_BYTES);
+    return true;
+}
+
+void appendHeader(std::string& out, const uint32_t transferId, const uint64_t offset) {
+    out.append(MAGIC);
+    putLittleEndian(out, transferId, 4);
+    putLittleEndian(out, offset, 8);
+}
+
+}
+
+// Extensions end up in file names: a dot and a few letters or digits, like ".jpg"
+static bool validExtension(const std::string& extension) {
+    if (extension.size() < 2 || extension.size() > 5 || extension[0] != '.') return false;
+    return std::all_of(extension.begin() + 1, extension.end(), [](const char c) {
+        return std::isalnum(static_cast<unsigned char>(c));
+    });
+}
+
+ImageUploads::ImageUploads(fs::path partDir) : partDir(std::move(partDir)) {
+    try {
+        fs::create_directories(this->partDir);
+    } catch (const fs::filesystem_error& e) {
+        LOG_ERROR("images", "Error creating upload directory", "path", this->partDir.string(), "error", e.what());
+    }
+}
+
+// <sha256>-<team>-<number>.part, with the team name hashed so any name makes a safe file name
+static std::string partFileName(const Sha256::Digest& expected, const std::string& team, const int number) {
+    Sha256 teamHasher;
+    teamHasher.update(team.data(), team.size());
+    const std::string teamHash = Sha256::toHex(teamHasher.finish()).substr(0, 16);
+    return Sha256::toHex(expected) + "-" + teamHash + "-" + std::to_string(number) + ".part";
+}
+
+void ImageUploads::removeStaleParts() {
+    std::error_code error;
+    const auto cutoff = fs::file_time_type::clock::now() - STALE_PART_AGE;
+    for (const auto& entry : fs::directory_iterator(partDir, error)) {
+        if (entry.path().extension() != ".part") continue;
+        if (entry.last_write_time(error) < cutoff && !error) {
+            LOG_INFO("images", "Removing stale upload", "path", entry.path().string());
+            fs::remove(entry.path(), error);
+        }
+    }
+}
+
+ImageUploads::Started ImageUploads::begin(const std::string& clientId, const std::string& team, const int number,
+                                          const std::string& extension, const uint64_t size, const std::string& sha256) {
+    TRACE_SCOPE("images", "uploadBegin");
+    Sha256::Digest expected;
+    if (!Sha256::fromHex(sha256, expected)) throw std::invalid_argument("sha256 must be 64 hex digits");
+    if (size == 0 || size > MAX_IMAGE_BYTES) throw std::invalid_argument("image size out of range: " + std::to_string(size));
+    if (!validExtension(extension)) throw std::invalid_argument("bad image extension: " + extension);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    removeStaleParts();
+
+    // The same photo for the same player already on its way (the client reconnected before
+    // its old connection closed): hand the transfer over. Two players may well share the
+    // same bytes (a placeholder), so a matching hash alone isn't enough.
+    for (auto& [id, upload] : uploads) {
+        if (upload.expected == expected && upload.size == size && upload.team == team && upload.number == number) {
+            upload.clientId = clientId;
+            upload.extension = extension;
+            return {id, upload.received};
+        }
+    }
+
+    Upload upload;
+    upload.clientId = clientId;
+    upload.team = team;
+    upload.number = number;
+    upload.extension = extension;
+    upload.size = size;
+    upload.expected = expected;
+    upload.file = partDir / partFileName(expected, team, number);
+
+    // Resume from a part file left by an earlier attempt. Its bytes are hashed again rather
+    // than trusted; anything longer than the declared size can't be this upload.
+    std::error_code error;
+    const uint64_t existing = fs::exists(upload.file, error) ? fs::file_size(upload.file, error) : 0;
+    if (existing > 0 && existing <= size && !error) {
+        std::ifstream in(upload.file, std::ios::binary);
+        std::vector<char> buffer(image_chunk::DATA_BYTES);
+        while (in.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || in.gcount() > 0) {
+            upload.hasher.update(buffer.data(), static_cast<size_t>(in.gcount()));
+            upload.received += static_cast<uint64_t>(in.gcount());
+        }
+        upload.out.open(upload.file, std::ios::binary | std::ios::app);
+    } else {
+        upload.out.open(upload.file, std::ios::binary | std::ios::trunc);
+    }
+    if (!upload.out) throw std::runtime_error("cannot open upload file " + upload.file.string());
+
+    if (upload.received > 0) {
+        LOG_INFO("images", "Resuming image upload", "team", team, "number", number, "offset", upload.received, "bytes", size);
+    }
+
+    uint32_t id = nextTransferId++;
+    if (id == 0) id = nextTransferId++;
+    const uint64_t offset = upload.received;
+    uploads.emplace(id, std::move(upload));
+    return {id, offset};
+}
+
+ImageUploads::ChunkResult ImageUploads::write(const std::string& clientId, const uint32_t transferId,
+                                              const uint64_t offset, const std::string_view data) {
+    TRACE_SCOPE("images", "uploadChunk");
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = uploads.find(transferId);
+    if (it == uploads.end() || it->second.clientId != clientId) return {ChunkStatus::UnknownTransfer, 0, std::nullopt, {}};
+    Upload& upload = it->second;
+
+    // Out of order or repeated after a resume: tell the client where to carry on
+    if (offset != upload.received) return {ChunkStatus::WrongOffset, upload.received, std::nullopt, {}};
+
+    auto fail = [&](std::string error) {
+        upload.out.close();
+        std::error_code ignored;
+        fs::remove(upload.file, ignored);
+        uploads.erase(it);
+        return ChunkResult{ChunkStatus::Failed, 0, std::nullopt, std::move(error)};
+    };
+
+    if (data.size() > upload.size - upload.received) return fail("chunk past the declared size");
+    upload.out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!upload.out) return fail("write failed");
+    upload.hasher.update(data.data(), data.size());
+    upload.received += data.size();
+
+    if (upload.received < upload.size) return {ChunkStatus::Accepted, upload.received, std::nullopt, {}};
+
+    upload.out.close();
+    if (upload.hasher.finish() != upload.expected) return fail("sha256 mismatch");
+
+    Finished finished{upload.team, upload.number, upload.extension, upload.file, upload.size};
+    uploads.erase(it);
+    return {ChunkStatus::Complete, finished.size, std::move(finished), {}};
+}
+
+void ImageUploads::dropClient(const std::string& clientId) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::erase_if(uploads, [&](const auto& entry) { return entry.second.clientId == clientId; });
+}
+
+size_t ImageUploads::active() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return uploads.size();
+}
+
+std::shared_ptr<ImageDownload> ImageDownload::open(const fs::path& file, const uint32_t transferId,
+                                                   const uint64_t offset, Counter* sentBytes) {
+    std::error_code error;
+    const uint64_t fileSize = fs::file_size(file, error);
+    if (error || offset > fileSize) return nullptr;
+
+    std::ifstream in(file, std::ios::binary);
+    if (!in || !in.seekg(static_cast<std::streamoff>(offset))) return nullptr;
+    return std::shared_ptr<ImageDownload>(new ImageDownload(std::move(in), transferId, offset, fileSize, sentBytes));
+}
+
+ImageDownload::ImageDownload(std::ifstream in, const uint32_t transferId, const uint64_t offset,
+                             const uint64_t fileSize, Counter* sentBytes)
+    : in(std::move(in)), transferId(transferId), offset(offset), fileSize(fileSize), sentBytes(sentBytes) {}
+
+std::optional<ClientMailbox::Message> ImageDownload::next() {
+    if (offset >= fileSize) return std::nullopt;
+    TRACE_SCOPE("images", "downloadChunk");
+
+    const size_t length = static_cast<size_t>(std::min<uint64_t>(image_chunk::DATA_BYTES, fileSize - offset));
+    std::string payload;
+    payload.reserve(image_chunk::HEADER_BYTES + length);
+    image_chunk::appendHeader(payload, transferId, offset);
+    payload.resize(image_chunk::HEADER_BYTES + length);
+    if (!in.read(payload.data() + image_chunk::HEADER_BYTES, static_cast<std::streamsize>(length))) {
+        // Replaced or truncated since the download started; the client's hash check fails
+        // and it asks again
+        LOG_WARN("images", "Image changed during download", "transfer", transferId, "offset", offset);
+        offset = fileSize;
+        return std::nullopt;
+    }
+    offset += length;
+    return ClientMailbox::Message{std::make_shared<const std::string>(std::move(payload)), true, sentBytes};
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "ClientMailbox.h"
+#include "Sha256.h"
+
+// Chunked player image transfers over binary WebSocket frames, so an image never has to be
+// held whole in memory or wrapped in base64 JSON.
+//
+// Chunk frame layout (little-endian), both directions:
+//   "PPC1" | uint32 transfer id | uint64 offset | data (at most DATA_BYTES)
+//
+// An upload starts with the uploadImage command (size and SHA-256 of the whole file). The
+// server answers with a transfer id and the offset to continue from, which is non-zero
+// when a part file from an interrupted upload with the same hash exists. Chunks are
+// appended to that part file; the last one checks the hash and the file is moved into
+// place. A download (downloadImage) answers with size and hash, then streams chunks read
+// from disk one at a time as the client's socket drains.
+namespace image_chunk {
+
+inline constexpr std::string_view MAGIC = "PPC1";
+inline constexpr size_t HEADER_BYTES = 16;
+inline constexpr size_t DATA_BYTES = 64 * 1024;
+
+[[nodiscard]] bool isChunk(std::string_view frame);
+// False if the frame is shorter than a header or carries more than DATA_BYTES
+[[nodiscard]] bool parse(std::string_view frame, uint32_t& transferId, uint64_t& offset, std::string_view& data);
+void appendHeader(std::string& out, uint32_t transferId, uint64_t offset);
+
+}
+
+// Uploads in progress. Part files live in their own directory, named by content hash and
+// player so an upload can resume after a reconnect (or a controller restart); only the open
+// file and a running hash are kept in memory. Thread-safe.
+class ImageUploads {
+public:
+    static constexpr uint64_t MAX_IMAGE_BYTES = 16 * 1024 * 1024;
+    // Part files untouched for this long are removed when the next upload starts
+    static constexpr auto STALE_PART_AGE = std::chrono::hours(24);
+
+    struct Started {
+        uint32_t transferId;
+        uint64_t offset; // Bytes already received; send from here
+    };
+
+    // A finished, verified upload waiting to be moved into place by the caller
+    struct Finished {
+        std::string team;
+        int number;
+        std::string extension;
+        std::filesystem::path file;
+        uint64_t size;
+    };
+
+    enum class ChunkStatus { Accepted, Complete, WrongOffset, UnknownTransfer, Failed };
+    struct ChunkResult {
+        ChunkStatus status;
+        uint64_t offset = 0;             // Bytes received so far (where the next chunk goes)
+        std::optional<Finished> finished; // Set when Complete
+        std::string error;               // Set when Failed
+    };
+
+    explicit ImageUploads(std::filesystem::path partDir);
+
+    // Throws std::invalid_argument for a bad size, hash or extension
+    Started begin(const std::string& clientId, const std::string& team, int number,
+                  const std::string& extension, uint64_t size, const std::string& sha256);
+    ChunkResult write(const std::string& clientId, uint32_t transferId, uint64_t offset, std::string_view data);
+    // Closes the client's part files but keeps them for a resume
+    void dropClient(const std::string& clientId);
+
+    [[nodiscard]] size_t active() const;
+
+private:
+    struct Upload {
+        std::string clientId;
+        std::string team;
+        int number = 0;
+        std::string extension;
+        uint64_t size = 0;
+        Sha256::Digest expected{};
+        std::filesystem::path file;
+        std::ofstream out;
+        Sha256 hasher;
+        uint64_t received = 0;
+    };
+
+    const std::filesystem::path partDir;
+    mutable std::mutex mutex;
+    std::unordered_map<uint32_t, Upload> uploads;
+    uint32_t nextTransferId = 1;
+
+    void removeStaleParts();
+};
+
+// One image download as a mailbox stream: reads DATA_BYTES at a time, so at most one chunk
+// per message in flight is ever in memory.
+class ImageDownload : public ClientMailbox::Stream {
+public:
+    // Nullptr if the file can't be opened or offset is past its end
+    static std::shared_ptr<ImageDownload> open(const std::filesystem::path& file, uint32_t transferId,
+                                               uint64_t offset, Counter* sentBytes);
+
+    [[nodiscard]] uint64_t size() const { return fileSize; }
+
+    std::optional<ClientMailbox::Message> next() override;
+
+private:
+    ImageDownload(std::ifstream in, uint32_t transferId, uint64_t offset, uint64_t fileSize, Counter* sentBytes);
+
+    std::ifstream in;
+    const uint32_t transferId;
+    uint64_t offset;
+    const uint64_t fileSize;
+    Counter* sentBytes;
+};
@@ -1,4 +1,5 @@
 #include "NetworkManager.h"
+#include "../Tracer.h"
 #include <iostream>
 #include <vector>
 #include <cstring>
@@ -79,6 +80,7 @@ static int query_callback(int sock, const struct sockaddr* from, size_t addrlen,
                          size_t size, size_t name_offset, size_t name_length, size_t record_offset,
                          size_t record_length, void* user_data) {
     if (entry != MDNS_ENTRYTYPE_QUESTION) return 0;
+    TRACE_SCOPE("mdns", "query");
 
     auto* records = static_cast<mDNSRecords*>(user_data);
     char name_buffer[256];
@@ -174,13 +176,18 @@ void NetworkManager::runmDNS() {
 
     void* buffer = malloc(2048);
     int check_counter = 0;
+    if (Tracer::enabled()) Tracer::setThreadName("mdns");
 
     while (running) {
         // Listen for queries (non-blocking-ish)
-        mdns_socket_listen(sock, buffer, 2048, query_callback, &records);
+        {
+            TRACE_SCOPE("mdns", "listen");
+            mdns_socket_listen(sock, buffer, 2048, query_callback, &records);
+        }
 
         // Every ~2 seconds (since listen has a timeout), send an unsolicited announcement
         if (++check_counter >= 20) { // Assuming listen loop is fast
+            TRACE_SCOPE("mdns", "announce");
             mdns_record_t ptr_record = {};
             ptr_record.name = {records.service_type.c_str(), records.service_type.length()};
             ptr_record.type = MDNS_RECORDTYPE_PTR;
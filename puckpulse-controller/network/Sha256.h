@@ -0,0 +1,34 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+// Incremental SHA-256 (FIPS 180-4), for checking and naming image content. Feed data with
+// update() in pieces of any size, then call finish() once.
+class Sha256 {
+public:
+    using Digest = std::array<uint8_t, 32>;
+
+    Sha256();
+
+    void update(const void* data, size_t size);
+    Digest finish();
+
+    static std::string toHex(const Digest& digest);
+    // Accepts upper or lower case; false unless `hex` is exactly 64 hex digits
+    static bool fromHex(const std::string& hex, Digest& digest);
+
+    // Hashes a file in fixed-size reads; false if it can't be read
+    static bool hashFile(const std::filesystem::path& path, Digest& digest);
+
+private:
+    std::array<uint32_t, 8> state;
+    std::array<uint8_t, 64> block{};
+    size_t blockUsed = 0;
+    uint64_t totalBytes = 0;
+
+    void compress(const uint8_t* chunk);
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// What a WebSocket client receives without asking each time. A client picks its topics
+// with ?topics=a,b on the connection URL and changes them with subscribe/unsubscribe;
+// without a topics parameter it gets DEFAULT_TOPICS, which is what every client got before
+// topics existed. The server builds a topic's messages only when someone subscribes to it.
+enum class Topic : uint8_t {
+    State,  // Scoreboard state and deltas
+    Roster, // The teams list, on connect and on every change
+    Frames, // The PPF1 board preview (FrameStreamer)
+    Stats,  // Metrics and client list, every STATS_INTERVAL
+};
+
+inline constexpr size_t TOPIC_COUNT = 4;
+inline constexpr std::array<std::string_view, TOPIC_COUNT> TOPIC_NAMES = {"state", "roster", "frames", "stats"};
+
+// One bit per Topic
+using TopicSet = uint8_t;
+
+constexpr TopicSet topicBit(const Topic topic) {
+    return static_cast<TopicSet>(1u << static_cast<unsigned>(topic));
+}
+
+constexpr bool hasTopic(const TopicSet topics, const Topic topic) {
+    return (topics & topicBit(topic)) != 0;
+}
+
+inline constexpr TopicSet DEFAULT_TOPICS = topicBit(Topic::State) | topicBit(Topic::Roster);
+
+constexpr bool parseTopic(const std::string_view name, Topic& topic) {
+    for (size_t i = 0; i < TOPIC_COUNT; ++i) {
+        if (TOPIC_NAMES[i] == name) {
+            topic = static_cast<Topic>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// "state,roster" -> the set; unknown names are skipped and counted in `unknown`
+constexpr TopicSet parseTopicList(std::string_view list, size_t& unknown) {
+    TopicSet topics = 0;
+    unknown = 0;
+    while (!list.empty()) {
+        const size_t comma = list.find(',');
+        const std::string_view name = list.substr(0, comma);
+        Topic topic{};
+        if (parseTopic(name, topic)) {
+            topics |= topicBit(topic);
+        } else if (!name.empty()) {
+            unknown++;
+        }
+        list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+    }
+    return topics;
+}
@@ -1,43 +1,108 @@
 #include "WebSocketManager.h"
 #include "../ScoreboardController.h"
-#include <iostream>
+#include "FrameStreamer.h"
+#include "../DiagnosticOverlay.h"
+#include "../Tracer.h"
+#include "../Log.h"
+#include "../AllocationTracker.h"
 #include <nlohmann/json.hpp>
+#include <algorithm>
+#include <array>
 #include <fstream>
+#include <stdexcept>
+#include <string_view>
 
 using json = nlohmann::json;
 
+// Topics from the connection URL's query (ws://host:port/?topics=state,frames); an empty
+// list subscribes to nothing, and without the parameter the client gets DEFAULT_TOPICS
+static TopicSet topicsFromUri(const std::string& uri, size_t& unknown) {
+    unknown = 0;
+    const size_t query = uri.find('?');
+    if (query == std::string::npos) return DEFAULT_TOPICS;
+    std::string_view params = std::string_view(uri).substr(query + 1);
+    while (!params.empty()) {
+        const size_t amp = params.find('&');
+        const std::string_view param = params.substr(0, amp);
+        if (param.starts_with("topics=")) return parseTopicList(param.substr(7), unknown);
+        params = amp == std::string_view::npos ? std::string_view{} : params.substr(amp + 1);
+    }
+    return DEFAULT_TOPICS;
+}
+
+// "topics": ["state", "stats"] in subscribe/unsubscribe; an unknown name fails the command
+static TopicSet topicsFromJson(const json& names) {
+    TopicSet topics = 0;
+    for (const json& name : names) {
+        Topic topic{};
+        if (!parseTopic(name.get_ref<const std::string&>(), topic)) {
+            throw std::invalid_argument("unknown topic: " + name.get<std::string>());
+        }
+        topics |= topicBit(topic);
+    }
+    return topics;
+}
+
 json WebSocketManager::teamsToJson() {
     json teamsList = json::array();
     for (const auto& name : teamManager.getTeamNames()) {
         const Team* t = teamManager.getTeam(name);
         if (t) {
-            json teamJson;
-            teamJson["name"] = t->name;
-            json playersList = json::array();
-            for (const auto& p : t->players) {
-                json pJson;
-                pJson["name"] = p.name;
-                pJson["number"] = p.number;
-                pJson["hasImage"] = !p.imagePath.empty();
-                playersList.push_back(pJson);
+            json team = wire::teamToJson(*t);
+            // Content hash per photo: the name to fetch it by over HTTP (/images/<hash>),
+            // and a way for clients to tell which cached photos are still current
+            for (json& player : team["players"]) {
+                if (!player.value("hasImage", false)) continue;
+                const auto file = teamManager.getPlayerImagePath(name, player.at("number").get<int>());
+                const std::string hash = file.empty() ? "" : imageCache.hashOf(file);
+                if (!hash.empty()) player["imageHash"] = hash;
             }
-            teamJson["players"] = playersList;
-            teamsList.push_back(teamJson);
+            teamsList.push_back(std::move(team));
         }
     }
     return teamsList;
 }
 
-WebSocketManager::WebSocketManager(int port, ScoreboardController& controller, TeamManager& teamManager, const Base64Coder& base64Coder)
-    : port(port), controller(controller), teamManager(teamManager), base64Coder(base64Coder), server(port, "0.0.0.0") {
+WebSocketManager::WebSocketManager(int port, ScoreboardController& controller, TeamManager& teamManager, const Base64Coder& base64Coder, ImageCache& imageCache, FrameStreamer& frameStreamer, Metrics& metrics, DiagnosticOverlay& overlay)
+    : port(port), controller(controller), teamManager(teamManager), base64Coder(base64Coder), imageCache(imageCache), frameStreamer(frameStreamer), metrics(metrics), overlay(overlay), server(port, "0.0.0.0"),
+      uploads(teamManager.getUploadsDirPath()) {
+
+    for (size_t i = 0; i < commandMetrics.size(); ++i) {
+        const char* cmd = commandName(static_cast<CommandId>(i));
+        commandMetrics[i] = {
+            cmd,
+            &metrics.counter("puckpulse_ws_commands_total", "WebSocket commands received", "command", cmd),
+            &metrics.histogram("puckpulse_ws_command_seconds", "Time to parse and handle a WebSocket command", "command", cmd),
+        };
+    }
+    commandErrors = &metrics.counter("puckpulse_ws_command_errors_total", "WebSocket messages that failed to parse or handle");
+    stateBytesFull = &metrics.counter("puckpulse_ws_state_bytes_total", "Scoreboard state bytes sent to WebSocket clients", "kind", "full");
+    stateBytesDelta = &metrics.counter("puckpulse_ws_state_bytes_total", "Scoreboard state bytes sent to WebSocket clients", "kind", "delta");
+    otherBytes = &metrics.counter("puckpulse_ws_message_bytes_total", "Roster, image and reply bytes sent to WebSocket clients");
+    statesReplaced = &metrics.counter("puckpulse_ws_states_replaced_total", "Unsent states replaced by a newer one for a slow WebSocket client");
+    messagesDropped = &metrics.counter("puckpulse_ws_messages_dropped_total", "Queued messages dropped because a WebSocket client fell too far behind");
+    imageBytesUp = &metrics.counter("puckpulse_ws_image_chunk_bytes_total", "Player image bytes moved in chunked transfers", "direction", "upload");
+    imageBytesDown = &metrics.counter("puckpulse_ws_image_chunk_bytes_total", "Player image bytes moved in chunked transfers", "direction", "download");
+    metrics.gauge("puckpulse_ws_image_uploads_active", "Chunked image uploads in progress", [this] {
+        return static_cast<double>(uploads.active());
+    });
+    metrics.gauge("puckpulse_ws_outbound_queued_bytes", "Bytes waiting in WebSocket client mailboxes", [this] {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        size_t bytes = 0;
+        for (const auto& [id, client] : clients) bytes += client.mailbox->stats().queuedBytes;
+        return static_cast<double>(bytes);
+    });
+
+    const ScoreboardSnapshotPtr initial = controller.snapshot();
+    lastBroadcastState = initial->state;
+    lastBroadcastVersion = initial->version;
     
     server.setOnConnectionCallback([this](std::weak_ptr<ix::WebSocket> webSocket, std::shared_ptr<ix::ConnectionState> connectionState) {
         auto ws = webSocket.lock();
         if (ws) {
             ws->setOnMessageCallback([this, connectionState, webSocket](const ix::WebSocketMessagePtr& msg) {
-                auto ws = webSocket.lock();
-                if (ws) {
-                    handleMessage(connectionState, *ws, msg);
+                if (!webSocket.expired()) {
+                    handleMessage(connectionState, webSocket, msg);
                 }
             });
         }
@@ -51,242 +116,672 @@ WebSocketManager::~WebSocketManager() {
 void WebSocketManager::start() {
     auto res = server.listen();
     if (!res.first) {
-        std::cerr << "Error: WebSocket server failed to listen on port " << port << ": " << res.second << std::endl;
+        LOG_ERROR("ws", "WebSocket server failed to listen", "port", port, "error", res.second);
         return;
     }
     server.start();
-    std::cout << "WebSocket server started on port " << port << " (Large payload support enabled)" << std::endl;
+    senderThread = std::thread(&WebSocketManager::senderLoop, this);
+    LOG_INFO("ws", "WebSocket server started", "port", port);
 }
 
 void WebSocketManager::stop() {
     server.stop();
+    {
+        std::lock_guard<std::mutex> lock(senderMutex);
+        stopping = true;
+    }
+    senderWake.notify_one();
+    if (senderThread.joinable()) {
+        senderThread.join();
+    }
 }
 
-void WebSocketManager::broadcastState(const ScoreboardState& state) {
-    json j = stateToJson(state);
-    std::string payload = j.dump();
-    
-    for (auto&& client : server.getClients()) {
-        client->send(payload);
+void WebSocketManager::broadcastState(const ScoreboardSnapshot& snapshot) {
+    TRACE_SCOPE("ws", "broadcastState");
+    // No one to send to: only move the base along, so the next delta covers just its change
+    if (!hasSubscribers(Topic::State)) {
+        lastBroadcastState = snapshot.state;
+        lastBroadcastVersion = snapshot.version;
+        return;
     }
+    json changes = wire::stateChanges(lastBroadcastState, snapshot.state);
+    // Nothing clients can see changed (e.g. only the tenths while the clock runs), so
+    // nothing is sent and the base stays at the last version clients were sent. Every
+    // version up to the next delta looks the same to them, and as changes carry whole field
+    // values, that delta also applies to a full state taken at any of those versions (on
+    // connect, "hello" or "getState"): clients accept base <= their seq < seq.
+    if (changes.empty()) return;
+
+    // Each message is built and encoded once per encoding, and only if some client takes it
+    json full;
+    json delta;
+    std::array<std::shared_ptr<const std::string>, wire::ENCODING_COUNT> fullPayloads;
+    std::array<std::shared_ptr<const std::string>, wire::ENCODING_COUNT> deltaPayloads;
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        for (auto& [id, client] : clients) {
+            if (client.socket.expired() || !hasTopic(client.topics, Topic::State)) continue;
+            const auto encoding = static_cast<size_t>(client.encoding);
+            ClientMailbox::Message message;
+            message.binary = wire::isBinary(client.encoding);
+            // A delta only applies on top of the last state the client was sent, so one
+            // that would replace an unsent state goes out as a full state instead
+            if (client.stateDeltas && !client.mailbox->statePending()) {
+                if (delta.is_null()) {
+                    delta["type"] = "stateDelta";
+                    delta["seq"] = snapshot.version;
+                    delta["base"] = lastBroadcastVersion;
+                    delta["changes"] = std::move(changes);
+                }
+                auto& payload = deltaPayloads[encoding];
+                if (!payload) payload = std::make_shared<const std::string>(wire::encode(delta, client.encoding));
+                message.payload = payload;
+                message.sentBytes = stateBytesDelta;
+            } else {
+                if (full.is_null()) full = stateMessage(snapshot);
+                auto& payload = fullPayloads[encoding];
+                if (!payload) payload = std::make_shared<const std::string>(wire::encode(full, client.encoding));
+                message.payload = payload;
+                message.sentBytes = stateBytesFull;
+            }
+            if (client.mailbox->postState(std::move(message))) statesReplaced->add();
+        }
+    }
+    wakeSender();
+
+    lastBroadcastState = snapshot.state;
+    lastBroadcastVersion = snapshot.version;
+}
+
+bool WebSocketManager::hasSubscribers(const Topic topic) {
+    std::lock_guard<std::mutex> lock(clientsMutex);
+    for (const auto& [id, client] : clients) {
+        if (hasTopic(client.topics, topic)) return true;
+    }
+    return false;
+}
+
+// Built outside clientsMutex: the roster reads and hashes photos, the stats list clients
+void WebSocketManager::publish(const Topic topic, const std::function<json()>& build) {
+    if (!hasSubscribers(topic)) return;
+    const json message = build();
+    std::array<std::shared_ptr<const std::string>, wire::ENCODING_COUNT> payloads;
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        for (auto& [id, client] : clients) {
+            if (client.socket.expired() || !hasTopic(client.topics, topic)) continue;
+            auto& payload = payloads[static_cast<size_t>(client.encoding)];
+            if (!payload) payload = std::make_shared<const std::string>(wire::encode(message, client.encoding));
+            messagesDropped->add(client.mailbox->post({payload, wire::isBinary(client.encoding), otherBytes}));
+        }
+    }
+    wakeSender();
+}
+
+void WebSocketManager::reply(const std::string& clientId, const json& message) {
+    std::shared_ptr<ClientMailbox> mailbox;
+    WireEncoding encoding = WireEncoding::Json;
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        auto it = clients.find(clientId);
+        if (it == clients.end()) return;
+        mailbox = it->second.mailbox;
+        encoding = it->second.encoding;
+    }
+    auto payload = std::make_shared<const std::string>(wire::encode(message, encoding));
+    messagesDropped->add(mailbox->post({std::move(payload), wire::isBinary(encoding), otherBytes}));
+    wakeSender();
+}
+
+// A full state to one client, taking the place of any state it hasn't been sent yet
+void WebSocketManager::replyStream(const std::string& clientId, std::shared_ptr<ClientMailbox::Stream> stream) {
+    std::shared_ptr<ClientMailbox> mailbox;
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        auto it = clients.find(clientId);
+        if (it == clients.end()) return;
+        mailbox = it->second.mailbox;
+    }
+    mailbox->postStream(std::move(stream));
+    wakeSender();
+}
+
+void WebSocketManager::replyState(const std::string& clientId, const json& message) {
+    std::shared_ptr<ClientMailbox> mailbox;
+    WireEncoding encoding = WireEncoding::Json;
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        auto it = clients.find(clientId);
+        if (it == clients.end()) return;
+        mailbox = it->second.mailbox;
+        encoding = it->second.encoding;
+    }
+    auto payload = std::make_shared<const std::string>(wire::encode(message, encoding));
+    if (mailbox->postState({std::move(payload), wire::isBinary(encoding), stateBytesFull})) statesReplaced->add();
+    wakeSender();
+}
+
+void WebSocketManager::wakeSender() {
+    {
+        std::lock_guard<std::mutex> lock(senderMutex);
+        sendRequested = true;
+    }
+    senderWake.notify_one();
+}
+
+void WebSocketManager::publishStats() {
+    publish(Topic::Stats, [this] { return statsMessage(); });
 }
 
-void WebSocketManager::handleMessage(std::shared_ptr<ix::ConnectionState> connectionState, ix::WebSocket & webSocket, const ix::WebSocketMessagePtr & msg) {
+// Wakes for new messages, every SEND_RETRY_INTERVAL while a client is backed up, and every
+// STATS_INTERVAL for the stats topic
+void WebSocketManager::senderLoop() {
+    bool backedUp = false;
+    auto nextStats = std::chrono::steady_clock::now() + STATS_INTERVAL;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(senderMutex);
+            auto ready = [this] { return sendRequested || stopping; };
+            const auto deadline = backedUp ? std::min(nextStats, std::chrono::steady_clock::now() + SEND_RETRY_INTERVAL)
+                                           : nextStats;
+            senderWake.wait_until(lock, deadline, ready);
+            if (stopping) return;
+            sendRequested = false;
+        }
+        if (std::chrono::steady_clock::now() >= nextStats) {
+            nextStats += STATS_INTERVAL;
+            // Don't try to catch up after a stall
+            if (nextStats < std::chrono::steady_clock::now()) nextStats = std::chrono::steady_clock::now() + STATS_INTERVAL;
+            publishStats(); // Queued just below; the wake-up it requests only costs a pass
+        }
+        backedUp = sendPending();
+    }
+}
+
+bool WebSocketManager::sendPending() {
+    AllocationScope allocations(AllocationSubsystem::Network);
+    TRACE_SCOPE("ws", "sendPending");
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        for (auto& [id, client] : clients) {
+            if (auto socket = client.socket.lock()) sendTargets.emplace_back(std::move(socket), client.mailbox);
+        }
+    }
+
+    bool backedUp = false;
+    for (auto& [socket, mailbox] : sendTargets) {
+        while (socket->bufferedAmount() < MAX_BUFFERED_BYTES) {
+            std::optional<ClientMailbox::Message> message = mailbox->take();
+            if (!message) break;
+            socket->send(*message->payload, message->binary);
+            if (message->sentBytes) message->sentBytes->add(message->payload->size());
+        }
+        if (!mailbox->empty()) backedUp = true;
+    }
+    sendTargets.clear(); // Don't keep closed connections alive until the next wake-up
+    return backedUp;
+}
+
+json WebSocketManager::clientsToJson() {
+    json list = json::array();
+    std::lock_guard<std::mutex> lock(clientsMutex);
+    for (const auto& [id, client] : clients) {
+        const ClientMailbox::Stats stats = client.mailbox->stats();
+        json c;
+        c["id"] = id;
+        c["remote"] = client.remote;
+        c["encoding"] = wire::encodingName(client.encoding);
+        c["stateDeltas"] = client.stateDeltas;
+        json topics = json::array();
+        for (size_t i = 0; i < TOPIC_COUNT; ++i) {
+            if (hasTopic(client.topics, static_cast<Topic>(i))) topics.push_back(TOPIC_NAMES[i]);
+        }
+        c["topics"] = std::move(topics);
+        c["queuedMessages"] = stats.queuedMessages;
+        c["queuedBytes"] = stats.queuedBytes;
+        c["streams"] = stats.streams;
+        c["statesReplaced"] = stats.statesReplaced;
+        c["messagesDropped"] = stats.messagesDropped;
+        list.push_back(c);
+    }
+    return list;
+}
+
+WireEncoding WebSocketManager::encodingOf(const std::string& clientId) {
+    std::lock_guard<std::mutex> lock(clientsMutex);
+    auto it = clients.find(clientId);
+    return it != clients.end() ? it->second.encoding : WireEncoding::Json;
+}
+
+void WebSocketManager::lastCommand(const char*& name, uint64_t& latencyNs) const {
+    // Two separate loads: a command finishing in between can pair one's name with the
+    // other's time, which the overlay can live with
+    name = lastCommandName.load(std::memory_order_relaxed);
+    latencyNs = lastCommandNs.load(std::memory_order_relaxed);
+}
+
+void WebSocketManager::handleMessage(std::shared_ptr<ix::ConnectionState> connectionState, std::weak_ptr<ix::WebSocket> socket, const ix::WebSocketMessagePtr & msg) {
+    AllocationScope allocations(AllocationSubsystem::Network);
     if (msg->type == ix::WebSocketMessageType::Message) {
+        const auto received = std::chrono::steady_clock::now();
+        TRACE_SCOPE("ws", "handleMessage");
+        const CommandMetrics* commandMetric = nullptr;
         try {
-            json j = json::parse(msg->str);
-            std::string cmd = j.value("command", "");
-            
-            if (cmd != "getImage") {
-                std::cout << "[WebSocket] Received command: " << cmd << " (Size: " << msg->str.length() << " bytes)" << std::endl;
+            // Image chunks can't be mistaken for a command: an encoded command is a map,
+            // which never starts with 'P' in CBOR or MessagePack
+            if (msg->binary && image_chunk::isChunk(msg->str)) {
+                handleImageChunk(connectionState->getId(), msg->str);
+                return;
             }
+            // Text frames are always JSON; binary ones use the encoding the client negotiated
+            const WireEncoding encoding = encodingOf(connectionState->getId());
+            json j = msg->binary ? wire::decode(msg->str, encoding) : json::parse(msg->str);
+            // One parse, then the command name is looked up once in the perfect-hash table
+            const auto command = j.find("command");
+            const CommandId id = command != j.end() && command->is_string()
+                ? findCommand(command->get_ref<const std::string&>())
+                : CommandId::Unknown;
 
-            if (cmd == "getTeams") {
-                json response;
-                response["type"] = "teams";
-                response["teams"] = teamsToJson();
-                webSocket.send(response.dump());
-                return;
-            } else if (cmd == "uploadPlayerImage") {
-                std::string teamName = j.at("team").get<std::string>();
-                int playerNumber = j.at("number").get<int>();
-                std::string base64Data = j.at("data").get<std::string>();
-                std::string ext = j.value("ext", ".jpg");
-
-                std::cout << "[WebSocket] Uploading image for " << teamName << " #" << playerNumber << " (" << base64Data.length() << " base64 chars)" << std::endl;
-
-                auto decoded = base64Coder.decode(base64Data);
-                if (!decoded.empty()) {
-                    if (teamManager.savePlayerImage(teamName, playerNumber, decoded, ext)) {
-                        std::cout << "[WebSocket] Image saved successfully. Broadcasting update." << std::endl;
-                        json response;
-                        response["type"] = "teams";
-                        response["teams"] = teamsToJson();
-                        std::string respPayload = response.dump();
-                        for (auto&& client : server.getClients()) {
-                            client->send(respPayload);
-                        }
-                    } else {
-                        std::cerr << "[WebSocket] Failed to save player image." << std::endl;
-                    }
+            commandMetric = &commandMetrics[static_cast<size_t>(id)];
+            commandMetric->count->add();
+
+            if (id != CommandId::GetImage) {
+                LOG_INFO("ws", "Received command", "command", commandName(id), "bytes", msg->str.length(), "client", connectionState->getId());
+            }
+
+            handleCommand(id, j, connectionState->getId(), socket, encoding);
+        } catch (const std::exception& e) {
+            commandErrors->add();
+            LOG_WARN("ws", "Error handling message", "error", e.what(), "client", connectionState->getId());
+        }
+        // Recorded once the command is done (or failed), then published for the overlay
+        if (commandMetric) {
+            const auto elapsed = std::chrono::steady_clock::now() - received;
+            commandMetric->latency->record(elapsed);
+            lastCommandNs.store(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+                                std::memory_order_relaxed);
+            lastCommandName.store(commandMetric->name, std::memory_order_relaxed);
+        }
+    } else if (msg->type == ix::WebSocketMessageType::Open) {
+        LOG_INFO("ws", "Client connected", "client", connectionState->getId(), "remote", connectionState->getRemoteIp());
+        connectedClients.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            Client& client = clients[connectionState->getId()];
+            client.socket = socket;
+            client.remote = connectionState->getRemoteIp();
+            client.mailbox = std::make_shared<ClientMailbox>(MAX_QUEUED_BYTES);
+        }
+        size_t unknown = 0;
+        const TopicSet topics = topicsFromUri(msg->openInfo.uri, unknown);
+        if (unknown > 0) {
+            LOG_WARN("ws", "Unknown topics in connection URL ignored", "uri", msg->openInfo.uri,
+                     "client", connectionState->getId());
+        }
+        // The current value of each topic, always JSON (a client switches encoding with "hello")
+        subscribe(connectionState->getId(), socket, topics, FrameStreamer::DEFAULT_MAX_FPS);
+    } else if (msg->type == ix::WebSocketMessageType::Close) {
+        LOG_INFO("ws", "Client disconnected", "client", connectionState->getId());
+        connectedClients.fetch_sub(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            clients.erase(connectionState->getId());
+        }
+        frameStreamer.unsubscribe(connectionState->getId());
+        uploads.dropClient(connectionState->getId());
+    } else if (msg->type == ix::WebSocketMessageType::Error) {
+        LOG_WARN("ws", "WebSocket error", "error", msg->errorInfo.reason, "client", connectionState->getId());
+    }
+}
+
+// Throws on missing or mistyped fields; handleMessage() counts and logs the error
+void WebSocketManager::handleCommand(const CommandId id, const json& j, const std::string& clientId,
+                                     const std::weak_ptr<ix::WebSocket>& socket, const WireEncoding encoding) {
+    if (isScoreboardCommand(id)) {
+        submit(parseScoreboardCommand(id, j));
+        return;
+    }
+
+    switch (id) {
+        case CommandId::Hello: {
+            // Opt in to delta broadcasts and/or a binary encoding. The client is updated
+            // before the snapshot is read, so any change newer than the full state sent
+            // here also reaches it as a delta; one sent before it is ignored as stale.
+            const bool stateDeltas = j.value("stateDeltas", false);
+            WireEncoding requested = WireEncoding::Json;
+            if (!wire::parseEncoding(j.value("encoding", "json"), requested)) {
+                LOG_WARN("ws", "Unknown encoding requested, using json", "encoding", j.value("encoding", ""),
+                         "client", clientId);
+            }
+            {
+                std::lock_guard<std::mutex> lock(clientsMutex);
+                auto it = clients.find(clientId);
+                if (it == clients.end()) return;
+                it->second.stateDeltas = stateDeltas;
+                it->second.encoding = requested;
+            }
+            json response;
+            response["type"] = "hello";
+            response["stateDeltas"] = stateDeltas;
+            response["encoding"] = wire::encodingName(requested);
+            reply(clientId, response);
+            replyState(clientId, stateMessage(*controller.snapshot()));
+            return;
+        }
+        case CommandId::GetState: {
+            // Resync after a client saw a gap in the delta sequence
+            replyState(clientId, stateMessage(*controller.snapshot()));
+            return;
+        }
+        case CommandId::GetTeams: {
+            reply(clientId, teamsMessage());
+            return;
+        }
+        case CommandId::UploadPlayerImage: {
+            std::string teamName = j.at("team").get<std::string>();
+            int playerNumber = j.at("number").get<int>();
+            std::string ext = j.value("ext", ".jpg");
+
+            auto decoded = wire::bytesFromJson(j.at("data"), base64Coder);
+            LOG_INFO("ws", "Uploading player image", "team", teamName, "number", playerNumber, "bytes", decoded.size());
+
+            if (!decoded.empty()) {
+                if (teamManager.savePlayerImage(teamName, playerNumber, decoded, ext)) {
+                    LOG_INFO("ws", "Player image saved, broadcasting teams", "team", teamName, "number", playerNumber);
+                    broadcastTeams();
                 } else {
-                    std::cerr << "[WebSocket] Base64 decode failed or data empty." << std::endl;
+                    LOG_ERROR("ws", "Failed to save player image", "team", teamName, "number", playerNumber);
                 }
+            } else {
+                LOG_WARN("ws", "Player image upload empty or not decodable", "team", teamName, "number", playerNumber);
+            }
+            return;
+        }
+        case CommandId::GetImage: {
+            std::string teamName = j.at("team").get<std::string>();
+            int playerNumber = j.at("number").get<int>();
+            auto imageData = teamManager.getPlayerImage(teamName, playerNumber);
+            
+            json response;
+            response["type"] = "image";
+            response["team"] = teamName;
+            response["number"] = playerNumber;
+            if (!imageData.empty()) {
+                response["data"] = wire::bytesToJson(imageData, encoding, base64Coder);
+            } else {
+                response["data"] = nullptr;
+            }
+            reply(clientId, response);
+            return;
+        }
+        case CommandId::UploadImage: {
+            const std::string teamName = j.at("team").get<std::string>();
+            const int playerNumber = j.at("number").get<int>();
+            if (!teamManager.hasPlayer(teamName, playerNumber)) {
+                replyUploadFailed(clientId, 0, teamName, playerNumber, "unknown player");
                 return;
-            } else if (cmd == "getImage") {
-                std::string teamName = j.at("team").get<std::string>();
-                int playerNumber = j.at("number").get<int>();
-                auto imageData = teamManager.getPlayerImage(teamName, playerNumber);
-                
-                json response;
-                response["type"] = "image";
-                response["team"] = teamName;
-                response["number"] = playerNumber;
-                if (!imageData.empty()) {
-                    response["data"] = base64Coder.encode(imageData);
-                } else {
-                    response["data"] = nullptr;
-                }
-                webSocket.send(response.dump());
+            }
+            ImageUploads::Started started{};
+            try {
+                started = uploads.begin(clientId, teamName, playerNumber, j.value("ext", ".jpg"),
+                                        j.at("size").get<uint64_t>(), j.at("sha256").get<std::string>());
+            } catch (const std::exception& e) {
+                replyUploadFailed(clientId, 0, teamName, playerNumber, e.what());
+                return;
+            }
+            LOG_INFO("ws", "Image upload started", "team", teamName, "number", playerNumber,
+                     "transfer", started.transferId, "offset", started.offset);
+            json response;
+            response["type"] = "uploadReady";
+            response["transferId"] = started.transferId;
+            response["offset"] = started.offset;
+            response["chunkBytes"] = image_chunk::DATA_BYTES;
+            reply(clientId, response);
+            return;
+        }
+        case CommandId::DownloadImage: {
+            const std::string teamName = j.at("team").get<std::string>();
+            const int playerNumber = j.at("number").get<int>();
+            const uint64_t offset = j.value("offset", uint64_t{0});
+
+            json response;
+            response["type"] = "imageBegin";
+            response["team"] = teamName;
+            response["number"] = playerNumber;
+
+            const std::filesystem::path file = teamManager.getPlayerImagePath(teamName, playerNumber);
+            const std::string hash = file.empty() ? "" : imageCache.hashOf(file);
+            const uint32_t transferId = nextDownloadId.fetch_add(1, std::memory_order_relaxed);
+            std::shared_ptr<ImageDownload> download;
+            if (!hash.empty()) {
+                download = ImageDownload::open(file, transferId, offset, imageBytesDown);
+            }
+            if (!download) {
+                response["found"] = false;
+                reply(clientId, response);
                 return;
-            } else if (cmd == "triggerGoal") {
-                bool isHome = j.at("isHome").get<bool>();
-                int playerNumber = j.value("playerNumber", 0);
-                
-                std::string teamName = isHome ? controller.getState().homeTeamName : controller.getState().awayTeamName;
+            }
+            response["found"] = true;
+            response["transferId"] = transferId;
+            response["size"] = download->size();
+            response["offset"] = offset;
+            response["sha256"] = hash;
+            response["chunkBytes"] = image_chunk::DATA_BYTES;
+            // The reply is queued ahead of the stream, so it always arrives before the chunks
+            reply(clientId, response);
+            replyStream(clientId, std::move(download));
+            return;
+        }
+        case CommandId::TriggerGoal: {
+            bool isHome = j.at("isHome").get<bool>();
+            int playerNumber = j.value("playerNumber", 0);
+            
+            const ScoreboardSnapshotPtr current = controller.snapshot();
+            std::string teamName = isHome ? current->state.homeTeamName : current->state.awayTeamName;
 
-                std::cout << "[WebSocket] Triggering goal for " << (isHome ? "Home" : "Away") << " (" << teamName << ") (Player: " << playerNumber << ")" << std::endl;
+            LOG_INFO("ws", "Triggering goal", "side", isHome ? "home" : "away", "team", teamName, "player", playerNumber);
 
-                // Increment score (Reliable like + button)
-                if (isHome) {
-                    controller.addHomeScore(1);
-                } else {
-                    controller.addAwayScore(1);
-                }
+            // Increment score (Reliable like + button)
+            if (isHome) {
+                submit(commands::AddHomeScore{1});
+            } else {
+                submit(commands::AddAwayScore{1});
+            }
 
-                if (playerNumber > 0) {
-                    const Team* team = teamManager.getTeam(teamName);
-                    if (team) {
-                        for (const auto& player : team->players) {
-                            if (player.number == playerNumber) {
-                                auto imageData = teamManager.getPlayerImage(teamName, playerNumber);
-                                controller.triggerGoalCelebration(player.name, playerNumber, imageData);
-                                return;
-                            }
+            if (playerNumber > 0) {
+                const Team* team = teamManager.getTeam(teamName);
+                if (team) {
+                    for (const auto& player : team->players) {
+                        if (player.number == playerNumber) {
+                            submit(commands::TriggerGoalCelebration{player.name, playerNumber,
+                                                                    teamManager.getPlayerImage(teamName, playerNumber)});
+                            return;
                         }
                     }
                 }
-                return;
             }
-            
-            handleCommand(msg->str);
-        } catch (const std::exception& e) {
-            std::cerr << "Error handling message: " << e.what() << std::endl;
+            return;
         }
-    } else if (msg->type == ix::WebSocketMessageType::Open) {
-        std::cout << "New WebSocket connection" << std::endl;
-        // Send initial state
-        json j = stateToJson(controller.getState());
-        webSocket.send(j.dump());
-        
-        // Also send teams on connect
-        json teamsResponse;
-        teamsResponse["type"] = "teams";
-        teamsResponse["teams"] = teamsToJson();
-        webSocket.send(teamsResponse.dump());
-    } else if (msg->type == ix::WebSocketMessageType::Close) {
-        std::cout << "WebSocket connection closed" << std::endl;
-    } else if (msg->type == ix::WebSocketMessageType::Error) {
-        std::cerr << "WebSocket error: " << msg->errorInfo.reason << std::endl;
-    }
-}
-
-void WebSocketManager::handleCommand(const std::string& payload) {
-    try {
-        json j = json::parse(payload);
-        std::string cmd = j.value("command", "");
-
-        if (cmd == "setHomeScore") controller.setHomeScore(j.at("value").get<int>());
-        else if (cmd == "setAwayScore") controller.setAwayScore(j.at("value").get<int>());
-        else if (cmd == "addHomeScore") controller.addHomeScore(j.value("delta", 1));
-        else if (cmd == "addAwayScore") controller.addAwayScore(j.value("delta", 1));
-        else if (cmd == "addHomeShots") controller.addHomeShots(j.value("delta", 1));
-        else if (cmd == "addAwayShots") controller.addAwayShots(j.value("delta", 1));
-        else if (cmd == "setHomeTeamName") controller.setHomeTeamName(j.at("value").get<std::string>());
-        else if (cmd == "setAwayTeamName") controller.setAwayTeamName(j.at("value").get<std::string>());
-        else if (cmd == "setHomePenalty") {
-            controller.setHomePenalty(j.at("index").get<int>(), j.at("value").get<int>(), j.at("player").get<int>());
-        }
-        else if (cmd == "setAwayPenalty") {
-            controller.setAwayPenalty(j.at("index").get<int>(), j.at("value").get<int>(), j.at("player").get<int>());
-        }
-        else if (cmd == "addHomePenalty") controller.addHomePenalty(j.at("value").get<int>(), j.value("player", 0));
-        else if (cmd == "addAwayPenalty") controller.addAwayPenalty(j.at("value").get<int>(), j.value("player", 0));
-        else if (cmd == "toggleClock") controller.toggleClock();
-        else if (cmd == "resetGame") controller.resetGame();
-        else if (cmd == "nextPeriod") controller.nextPeriod();
-        else if (cmd == "setTime") {
-            controller.setTime(j.at("minutes").get<int>(), j.at("seconds").get<int>());
-        }
-        else if (cmd == "setClockMode") {
-            std::string mode = j.at("value").get<std::string>();
-            if (mode == "Game") controller.setClockMode(ClockMode::Game);
-            else if (mode == "Intermission") controller.setClockMode(ClockMode::Intermission);
-            else if (mode == "TimeOfDay") controller.setClockMode(ClockMode::TimeOfDay);
-        }
-        else if (cmd == "addOrUpdatePlayer") {
+        case CommandId::Subscribe: {
+            subscribe(clientId, socket, topicsFromJson(j.at("topics")), j.value("maxFps", FrameStreamer::DEFAULT_MAX_FPS));
+            return;
+        }
+        case CommandId::Unsubscribe: {
+            unsubscribe(clientId, topicsFromJson(j.at("topics")));
+            return;
+        }
+        // Older spellings of subscribe/unsubscribe for the frames topic alone
+        case CommandId::SubscribeFrames: {
+            subscribe(clientId, socket, topicBit(Topic::Frames), j.value("maxFps", FrameStreamer::DEFAULT_MAX_FPS));
+            return;
+        }
+        case CommandId::UnsubscribeFrames: {
+            unsubscribe(clientId, topicBit(Topic::Frames));
+            return;
+        }
+        case CommandId::SetDiagnosticOverlay: {
+            if (j.contains("enabled")) {
+                overlay.setEnabled(j.at("enabled").get<bool>());
+            } else {
+                overlay.toggle();
+            }
+            return;
+        }
+        case CommandId::GetStats: {
+            reply(clientId, statsMessage());
+            return;
+        }
+        case CommandId::AddOrUpdatePlayer: {
             Player p;
             p.name = j.at("name").get<std::string>();
             p.number = j.at("number").get<int>();
             teamManager.addOrUpdatePlayer(j.at("team").get<std::string>(), p);
-            
-            // Broadcast teams update
-            json response;
-            response["type"] = "teams";
-            response["teams"] = teamsToJson();
-            std::string respPayload = response.dump();
-            for (auto&& client : server.getClients()) {
-                client->send(respPayload);
-            }
+            broadcastTeams();
+            return;
         }
-        else if (cmd == "removePlayer") {
+        case CommandId::RemovePlayer: {
             teamManager.removePlayer(j.at("team").get<std::string>(), j.at("number").get<int>());
-            
-            // Broadcast teams update
-            json response;
-            response["type"] = "teams";
-            response["teams"] = teamsToJson();
-            std::string respPayload = response.dump();
-            for (auto&& client : server.getClients()) {
-                client->send(respPayload);
-            }
+            broadcastTeams();
+            return;
         }
-        else if (cmd == "deleteTeam") {
+        case CommandId::DeleteTeam: {
             teamManager.deleteTeam(j.at("name").get<std::string>());
-             // Broadcast teams update
-            json response;
-            response["type"] = "teams";
-            response["teams"] = teamsToJson();
-            std::string respPayload = response.dump();
-            for (auto&& client : server.getClients()) {
-                client->send(respPayload);
-            }
+            broadcastTeams();
+            return;
         }
-    } catch (const std::exception& e) {
-        std::cerr << "Error parsing command JSON: " << e.what() << std::endl;
+        default:
+            return; // Unknown
     }
 }
 
-json WebSocketManager::stateToJson(const ScoreboardState& state) {
-    json j;
-    j["homeScore"] = state.homeScore;
-    j["awayScore"] = state.awayScore;
-    j["timeMinutes"] = state.timeMinutes;
-    j["timeSeconds"] = state.timeSeconds;
-    j["homeShots"] = state.homeShots;
-    j["awayShots"] = state.awayShots;
-    j["currentPeriod"] = state.currentPeriod;
-    j["homeTeamName"] = state.homeTeamName;
-    j["awayTeamName"] = state.awayTeamName;
-    j["isClockRunning"] = state.isClockRunning;
-    
-    std::string mode;
-    switch(state.clockMode) {
-        case ClockMode::Game: mode = "Game"; break;
-        case ClockMode::Intermission: mode = "Intermission"; break;
-        case ClockMode::TimeOfDay: mode = "TimeOfDay"; break;
+void WebSocketManager::handleImageChunk(const std::string& clientId, const std::string& frame) {
+    TRACE_SCOPE("ws", "imageChunk");
+    uint32_t transferId = 0;
+    uint64_t offset = 0;
+    std::string_view data;
+    if (!image_chunk::parse(frame, transferId, offset, data)) {
+        commandErrors->add();
+        LOG_WARN("ws", "Malformed image chunk", "bytes", frame.size(), "client", clientId);
+        return;
     }
-    j["clockMode"] = mode;
 
-    auto penaltiesToJson = [](const Penalty p[2]) {
-        json arr = json::array();
-        for(int i=0; i<2; ++i) {
-            arr.push_back({{"secondsRemaining", p[i].secondsRemaining}, {"playerNumber", p[i].playerNumber}});
+    ImageUploads::ChunkResult result = uploads.write(clientId, transferId, offset, data);
+    switch (result.status) {
+        case ImageUploads::ChunkStatus::Accepted:
+            imageBytesUp->add(data.size());
+            return;
+        case ImageUploads::ChunkStatus::WrongOffset: {
+            // Tell the client where to carry on; it restarts from there
+            json response;
+            response["type"] = "uploadReady";
+            response["transferId"] = transferId;
+            response["offset"] = result.offset;
+            response["chunkBytes"] = image_chunk::DATA_BYTES;
+            reply(clientId, response);
+            return;
         }
-        return arr;
-    };
-    j["homePenalties"] = penaltiesToJson(state.homePenalties);
-    j["awayPenalties"] = penaltiesToJson(state.awayPenalties);
-    
+        case ImageUploads::ChunkStatus::UnknownTransfer:
+            replyUploadFailed(clientId, transferId, "", 0, "unknown transfer");
+            return;
+        case ImageUploads::ChunkStatus::Failed:
+            LOG_WARN("ws", "Image upload failed", "transfer", transferId, "error", result.error, "client", clientId);
+            replyUploadFailed(clientId, transferId, "", 0, result.error);
+            return;
+        case ImageUploads::ChunkStatus::Complete:
+            break;
+    }
+
+    imageBytesUp->add(data.size());
+    const ImageUploads::Finished& finished = *result.finished;
+    if (!teamManager.adoptPlayerImage(finished.team, finished.number, finished.file, finished.extension)) {
+        std::error_code ignored;
+        std::filesystem::remove(finished.file, ignored);
+        replyUploadFailed(clientId, transferId, finished.team, finished.number, "could not store image");
+        return;
+    }
+    LOG_INFO("ws", "Image upload complete, broadcasting teams", "team", finished.team, "number", finished.number,
+             "bytes", finished.size);
+    json response;
+    response["type"] = "uploadComplete";
+    response["transferId"] = transferId;
+    response["team"] = finished.team;
+    response["number"] = finished.number;
+    reply(clientId, response);
+    broadcastTeams();
+}
+
+void WebSocketManager::replyUploadFailed(const std::string& clientId, const uint32_t transferId,
+                                         const std::string& team, const int number, const std::string& error) {
+    json response;
+    response["type"] = "uploadFailed";
+    response["transferId"] = transferId;
+    if (!team.empty()) {
+        response["team"] = team;
+        response["number"] = number;
+    }
+    response["error"] = error;
+    reply(clientId, response);
+}
+
+void WebSocketManager::broadcastTeams() {
+    publish(Topic::Roster, [this] { return teamsMessage(); });
+}
+
+void WebSocketManager::subscribe(const std::string& clientId, const std::weak_ptr<ix::WebSocket>& socket,
+                                 const TopicSet topics, const int maxFps) {
+    TopicSet added = 0;
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        auto it = clients.find(clientId);
+        if (it == clients.end()) return;
+        added = topics & ~it->second.topics;
+        it->second.topics |= topics;
+    }
+    // The topic bit is set before the value is read, like "hello": a change made meanwhile
+    // reaches the client too, and one older than what is sent here is ignored as stale
+    if (hasTopic(added, Topic::State)) replyState(clientId, stateMessage(*controller.snapshot()));
+    if (hasTopic(added, Topic::Roster)) reply(clientId, teamsMessage());
+    if (hasTopic(added, Topic::Stats)) reply(clientId, statsMessage());
+    if (hasTopic(topics, Topic::Frames)) frameStreamer.subscribe(clientId, socket, maxFps);
+}
+
+void WebSocketManager::unsubscribe(const std::string& clientId, const TopicSet topics) {
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        auto it = clients.find(clientId);
+        if (it == clients.end()) return;
+        it->second.topics &= static_cast<TopicSet>(~topics);
+    }
+    if (hasTopic(topics, Topic::Frames)) frameStreamer.unsubscribe(clientId);
+}
+
+json WebSocketManager::teamsMessage() {
+    json response;
+    response["type"] = "teams";
+    response["teams"] = teamsToJson();
+    return response;
+}
+
+json WebSocketManager::statsMessage() {
+    json response;
+    response["type"] = "stats";
+    response["stats"] = metrics.toJson();
+    response["clients"] = clientsToJson();
+    return response;
+}
+
+// The controller applies the command on the main loop's next tick
+void WebSocketManager::submit(ScoreboardCommand command) {
+    if (!controller.submit(std::move(command))) {
+        commandErrors->add();
+        LOG_WARN("ws", "Scoreboard command queue full, command dropped", "pending", controller.pendingCommands());
+    }
+}
+
+// The whole state, tagged with its version so delta clients know where to continue from
+json WebSocketManager::stateMessage(const ScoreboardSnapshot& snapshot) {
+    json j = wire::stateToJson(snapshot.state);
+    j["type"] = "state";
+    j["seq"] = snapshot.version;
     return j;
 }
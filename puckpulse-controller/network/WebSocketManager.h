@@ -1,34 +1,157 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <chrono>
 #include <ixwebsocket/IXWebSocketServer.h>
 #include <ixwebsocket/IXWebSocket.h>
 #include <nlohmann/json.hpp>
 #include "../ScoreboardState.h"
+#include "../ScoreboardCommand.h"
+#include "../ScoreboardSnapshot.h"
 #include "../TeamManager.h"
 #include "Base64Coder.h"
+#include "WireProtocol.h"
+#include "ClientMailbox.h"
+#include "CommandTable.h"
+#include "ImageTransfer.h"
+#include "ImageCache.h"
+#include "Topic.h"
+#include "../Metrics.h"
 
 class ScoreboardController;
+class FrameStreamer;
+class DiagnosticOverlay;
 
+// Outbound messages go through a ClientMailbox per client and are written by one sender
+// thread, which skips a client while its socket still has MAX_BUFFERED_BYTES unsent. A
+// client on a slow link then falls behind on its own (its pending state is replaced, old
+// roster/image messages are dropped) without holding up the others or growing memory.
+// Broadcasts go only to clients subscribed to their Topic, and a topic nobody subscribes
+// to is never built or encoded.
 class WebSocketManager {
 public:
-    WebSocketManager(int port, ScoreboardController& controller, TeamManager& teamManager, const Base64Coder& base64Coder);
+    // Roster, image and reply messages kept per client before the oldest are dropped
+    static constexpr size_t MAX_QUEUED_BYTES = 4 * 1024 * 1024;
+    // Stop writing to a client while this much is still in its socket's send buffer
+    static constexpr size_t MAX_BUFFERED_BYTES = 256 * 1024;
+    // How often the sender retries backed-up clients
+    static constexpr auto SEND_RETRY_INTERVAL = std::chrono::milliseconds(20);
+    // How often the sender thread pushes a stats message to Topic::Stats subscribers
+    static constexpr auto STATS_INTERVAL = std::chrono::seconds(1);
+
+    WebSocketManager(int port, ScoreboardController& controller, TeamManager& teamManager, const Base64Coder& base64Coder, ImageCache& imageCache, FrameStreamer& frameStreamer, Metrics& metrics, DiagnosticOverlay& overlay);
     ~WebSocketManager();
 
     void start();
     void stop();
 
-    void broadcastState(const ScoreboardState& state);
+    // Sends the change to every Topic::State subscriber: clients that asked for deltas get
+    // only the fields that differ from the previous broadcast, the rest the full state.
+    // Called on the controller's owner thread.
+    void broadcastState(const ScoreboardSnapshot& snapshot);
+
+    // For the diagnostic overlay; readable from any thread
+    [[nodiscard]] int clientCount() const { return connectedClients.load(std::memory_order_relaxed); }
+    // Name and handling time of the most recent command; name is nullptr before the first
+    void lastCommand(const char*& name, uint64_t& latencyNs) const;
 
 private:
     int port;
     ScoreboardController& controller;
     TeamManager& teamManager;
     const Base64Coder& base64Coder;
+    ImageCache& imageCache;
+    FrameStreamer& frameStreamer;
+    Metrics& metrics;
+    DiagnosticOverlay& overlay;
     ix::WebSocketServer server;
 
-    void handleMessage(std::shared_ptr<ix::ConnectionState> connectionState, ix::WebSocket & webSocket, const ix::WebSocketMessagePtr & msg);
-    void handleCommand(const std::string& payload);
-    nlohmann::json stateToJson(const ScoreboardState& state);
+    // Per-command counters/latencies, registered up front for every known command so a
+    // client cannot grow the metric set; anything else is counted as "unknown". Indexed by
+    // CommandId.
+    struct CommandMetrics {
+        const char* name;
+        Counter* count;
+        LatencyHistogram* latency;
+    };
+    std::array<CommandMetrics, COMMAND_COUNT + 1> commandMetrics{};
+    Counter* commandErrors;
+    std::atomic<const char*> lastCommandName{nullptr};
+    std::atomic<uint64_t> lastCommandNs{0};
+    std::atomic<int> connectedClients{0};
+    Counter* stateBytesFull;
+    Counter* stateBytesDelta;
+    Counter* otherBytes;
+    Counter* statesReplaced;
+    Counter* messagesDropped;
+    Counter* imageBytesUp;
+    Counter* imageBytesDown;
+
+    ImageUploads uploads;
+    std::atomic<uint32_t> nextDownloadId{1};
+
+    // Connected clients by connection id; registered on Open, removed on Close
+    struct Client {
+        std::weak_ptr<ix::WebSocket> socket;
+        std::string remote;
+        bool stateDeltas = false; // Sent "hello" with stateDeltas; legacy clients get full states
+        WireEncoding encoding = WireEncoding::Json;
+        TopicSet topics = 0; // Set from the connection URL on Open
+        std::shared_ptr<ClientMailbox> mailbox;
+    };
+    std::mutex clientsMutex;
+    std::unordered_map<std::string, Client> clients;
+
+    // --- Sender thread ---
+    std::mutex senderMutex;
+    std::condition_variable senderWake;
+    bool sendRequested = false;
+    bool stopping = false;
+    std::thread senderThread;
+    // Sender thread only; reused so a wake-up doesn't allocate
+    std::vector<std::pair<std::shared_ptr<ix::WebSocket>, std::shared_ptr<ClientMailbox>>> sendTargets;
+
+    // Broadcasting thread only: the state the next delta is computed against
+    ScoreboardState lastBroadcastState;
+    uint64_t lastBroadcastVersion = 0;
+
+    void handleMessage(std::shared_ptr<ix::ConnectionState> connectionState, std::weak_ptr<ix::WebSocket> socket, const ix::WebSocketMessagePtr & msg);
+    void handleCommand(CommandId id, const nlohmann::json& j, const std::string& clientId,
+                       const std::weak_ptr<ix::WebSocket>& socket, WireEncoding encoding);
+    void handleImageChunk(const std::string& clientId, const std::string& frame);
+    void replyUploadFailed(const std::string& clientId, uint32_t transferId, const std::string& team, int number,
+                           const std::string& error);
+    void broadcastTeams();
+    // Adds topics and sends the current state/roster/stats for each one the client didn't
+    // have; Frames (re)subscribes with FrameStreamer at maxFps
+    void subscribe(const std::string& clientId, const std::weak_ptr<ix::WebSocket>& socket, TopicSet topics, int maxFps);
+    void unsubscribe(const std::string& clientId, TopicSet topics);
+    void submit(ScoreboardCommand command);
+    WireEncoding encodingOf(const std::string& clientId);
+    // Queue a message for one client, in the encoding it negotiated
+    void reply(const std::string& clientId, const nlohmann::json& message);
+    void replyState(const std::string& clientId, const nlohmann::json& message);
+    void replyStream(const std::string& clientId, std::shared_ptr<ClientMailbox::Stream> stream);
+    bool hasSubscribers(Topic topic);
+    // Builds the message only if some client subscribes to the topic, and encodes it at
+    // most once per encoding
+    void publish(Topic topic, const std::function<nlohmann::json()>& build);
+    void publishStats();
+    void wakeSender();
+    void senderLoop();
+    bool sendPending(); // True when some client is backed up with messages left
+    nlohmann::json statsMessage();
+    nlohmann::json teamsMessage();
+    nlohmann::json clientsToJson();
+    nlohmann::json stateMessage(const ScoreboardSnapshot& snapshot);
     nlohmann::json teamsToJson();
 };
@@ -0,0 +1,132 @@
+#include "WireProtocol.h"
+#include <algorithm>
+
+using json = nlohmann::json;
+
+namespace wire {
+
+static const char* const ENCODING_NAMES[ENCODING_COUNT] = {"json", "cbor", "msgpack"};
+
+bool parseEncoding(const std::string& name, WireEncoding& encoding) {
+    for (size_t i = 0; i < ENCODING_COUNT; ++i) {
+        if (name == ENCODING_NAMES[i]) {
+            encoding = static_cast<WireEncoding>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* encodingName(const WireEncoding encoding) {
+    return ENCODING_NAMES[static_cast<size_t>(encoding)];
+}
+
+bool isBinary(const WireEncoding encoding) {
+    return encoding != WireEncoding::Json;
+}
+
+std::string encode(const json& message, const WireEncoding encoding) {
+    std::string payload;
+    switch (encoding) {
+        case WireEncoding::Json: return message.dump();
+        case WireEncoding::Cbor: json::to_cbor(message, payload); break;
+        case WireEncoding::MessagePack: json::to_msgpack(message, payload); break;
+    }
+    return payload;
+}
+
+json decode(const std::string& payload, const WireEncoding encoding) {
+    switch (encoding) {
+        case WireEncoding::Json: return json::parse(payload);
+        case WireEncoding::Cbor: return json::from_cbor(payload);
+        case WireEncoding::MessagePack: return json::from_msgpack(payload);
+    }
+    return json::parse(payload);
+}
+
+json bytesToJson(const std::vector<uint8_t>& data, const WireEncoding encoding, const Base64Coder& base64Coder) {
+    if (encoding == WireEncoding::Json) return base64Coder.encode(data);
+    return json::binary(data);
+}
+
+std::vector<uint8_t> bytesFromJson(const json& value, const Base64Coder& base64Coder) {
+    if (value.is_binary()) return value.get_binary();
+    return base64Coder.decode(value.get<std::string>());
+}
+
+static const char* clockModeName(const ClockMode mode) {
+    switch (mode) {
+        case ClockMode::Game: return "Game";
+        case ClockMode::Intermission: return "Intermission";
+        case ClockMode::TimeOfDay: return "TimeOfDay";
+    }
+    return "";
+}
+
+static json penaltiesToJson(const Penalty p[2]) {
+    json arr = json::array();
+    for (int i = 0; i < 2; ++i) {
+        arr.push_back({{"secondsRemaining", p[i].secondsRemaining}, {"playerNumber", p[i].playerNumber}});
+    }
+    return arr;
+}
+
+json stateToJson(const ScoreboardState& state) {
+    json j;
+    j["homeScore"] = state.homeScore;
+    j["awayScore"] = state.awayScore;
+    j["timeMinutes"] = state.timeMinutes;
+    j["timeSeconds"] = state.timeSeconds;
+    j["homeShots"] = state.homeShots;
+    j["awayShots"] = state.awayShots;
+    j["currentPeriod"] = state.currentPeriod;
+    j["homeTeamName"] = state.homeTeamName;
+    j["awayTeamName"] = state.awayTeamName;
+    j["isClockRunning"] = state.isClockRunning;
+    j["clockMode"] = clockModeName(state.clockMode);
+    j["homePenalties"] = penaltiesToJson(state.homePenalties);
+    j["awayPenalties"] = penaltiesToJson(state.awayPenalties);
+    return j;
+}
+
+json stateChanges(const ScoreboardState& from, const ScoreboardState& to) {
+    json changes = json::object();
+    auto field = [&changes](const char* key, const auto& before, const auto& after) {
+        if (before != after) changes[key] = after;
+    };
+    field("homeScore", from.homeScore, to.homeScore);
+    field("awayScore", from.awayScore, to.awayScore);
+    field("timeMinutes", from.timeMinutes, to.timeMinutes);
+    field("timeSeconds", from.timeSeconds, to.timeSeconds);
+    field("homeShots", from.homeShots, to.homeShots);
+    field("awayShots", from.awayShots, to.awayShots);
+    field("currentPeriod", from.currentPeriod, to.currentPeriod);
+    field("homeTeamName", from.homeTeamName, to.homeTeamName);
+    field("awayTeamName", from.awayTeamName, to.awayTeamName);
+    field("isClockRunning", from.isClockRunning, to.isClockRunning);
+    if (from.clockMode != to.clockMode) changes["clockMode"] = clockModeName(to.clockMode);
+    if (!std::equal(from.homePenalties, from.homePenalties + 2, to.homePenalties)) {
+        changes["homePenalties"] = penaltiesToJson(to.homePenalties);
+    }
+    if (!std::equal(from.awayPenalties, from.awayPenalties + 2, to.awayPenalties)) {
+        changes["awayPenalties"] = penaltiesToJson(to.awayPenalties);
+    }
+    return changes;
+}
+
+json teamToJson(const Team& team) {
+    json teamJson;
+    teamJson["name"] = team.name;
+    json playersList = json::array();
+    for (const auto& p : team.players) {
+        json pJson;
+        pJson["name"] = p.name;
+        pJson["number"] = p.number;
+        pJson["hasImage"] = !p.imagePath.empty();
+        playersList.push_back(pJson);
+    }
+    teamJson["players"] = playersList;
+    return teamJson;
+}
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "../ScoreboardState.h"
+#include "../TeamManager.h"
+#include "Base64Coder.h"
+
+// Encoding of the WebSocket control protocol. JSON in text frames is the default; a client
+// can ask for CBOR or MessagePack in its "hello", after which the server sends it binary
+// frames in that encoding and accepts binary commands in it. The message structure is the
+// same in every encoding, except that byte fields (player images) are native byte strings
+// in the binary encodings instead of base64 text.
+//
+// Binary frames that start with "PPF1" are board preview frames (FrameStreamer); every
+// control message is a map, and neither encoding starts a map with those bytes.
+enum class WireEncoding { Json, Cbor, MessagePack };
+
+namespace wire {
+
+inline constexpr size_t ENCODING_COUNT = 3;
+
+bool parseEncoding(const std::string& name, WireEncoding& encoding);
+const char* encodingName(WireEncoding encoding);
+// Whether messages in this encoding go out as binary WebSocket frames
+bool isBinary(WireEncoding encoding);
+
+std::string encode(const nlohmann::json& message, WireEncoding encoding);
+// Throws nlohmann::json::exception on malformed input, like json::parse()
+nlohmann::json decode(const std::string& payload, WireEncoding encoding);
+
+// Image bytes as the encoding carries them: base64 text in JSON, a byte string otherwise
+nlohmann::json bytesToJson(const std::vector<uint8_t>& data, WireEncoding encoding, const Base64Coder& base64Coder);
+// Accepts either form, whatever the client's encoding
+std::vector<uint8_t> bytesFromJson(const nlohmann::json& value, const Base64Coder& base64Coder);
+
+// --- Message bodies ---
+
+nlohmann::json stateToJson(const ScoreboardState& state);
+// The fields of `to` that differ from `from`, under the same keys as stateToJson().
+// Penalty arrays are sent whole when either slot changed.
+nlohmann::json stateChanges(const ScoreboardState& from, const ScoreboardState& to);
+nlohmann::json teamToJson(const Team& team);
+
+}
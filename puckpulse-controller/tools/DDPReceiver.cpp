@@ -0,0 +1,146 @@
+// Stand-in DDP receiver for testing the DDP output without a pixel controller.
+//
+// Listens on a UDP port, reassembles frames on the PUSH flag and prints per-second
+// statistics (frames, packets, bytes, sequence gaps and the packets they imply were lost),
+// so it doubles as the far end of a controller --soak run. Optionally writes the last
+// complete frame as a PPM image so the output can be inspected visually.
+//
+//   puckpulse-ddp-receiver [--port 4048] [--width 384] [--height 160] [--dump frame.ppm]
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <csignal>
+#include <atomic>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#define DDP_HEADER_SIZE 10
+#define DDP_FLAGS_PUSH 0x01
+
+std::atomic<bool> g_running{true};
+
+void signalHandler(int) {
+    g_running = false;
+}
+
+int main(int argc, char* argv[]) {
+    uint16_t port = 4048;
+    int width = 384, height = 160;
+    std::string dumpPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--port" && i + 1 < argc) port = static_cast<uint16_t>(std::stoi(argv[++i]));
+        else if (arg == "--width" && i + 1 < argc) width = std::stoi(argv[++i]);
+        else if (arg == "--height" && i + 1 < argc) height = std::stoi(argv[++i]);
+        else if (arg == "--dump" && i + 1 < argc) dumpPath = argv[++i];
+        else {
+            std::cout << "Usage: " << argv[0] << " [--port 4048] [--width 384] [--height 160] [--dump frame.ppm]" << std::endl;
+            return 0;
+        }
+    }
+
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0) {
+        perror("Socket creation failed");
+        return 1;
+    }
+
+    int rcvbuf = 4 * 1024 * 1024;
+    setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    // Wake up periodically so statistics are printed even when nothing arrives
+    timeval timeout{0, 200000};
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = INADDR_ANY;
+    addr.sin_port = htons(port);
+    if (bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        perror("Bind failed");
+        return 1;
+    }
+
+    std::signal(SIGINT, signalHandler);
+    std::signal(SIGTERM, signalHandler);
+
+    std::cout << "DDP receiver listening on UDP port " << port << " (" << width << "x" << height << ")" << std::endl;
+
+    const size_t frameBytes = static_cast<size_t>(width) * height * 3;
+    std::vector<uint8_t> frame(frameBytes, 0);
+    uint8_t packet[65536];
+
+    uint64_t packets = 0, bytes = 0, frames = 0, sequenceGaps = 0, lost = 0, shortFrames = 0;
+    uint64_t totalPackets = 0, totalFrames = 0, totalGaps = 0, totalLost = 0, totalShortFrames = 0;
+    size_t bytesThisFrame = 0;
+    int lastSequence = 0;
+    auto lastReport = std::chrono::steady_clock::now();
+
+    while (g_running) {
+        ssize_t len = recv(sock, packet, sizeof(packet), 0);
+        if (len >= DDP_HEADER_SIZE) {
+            const uint8_t flags = packet[0];
+            const int sequence = packet[1] & 0x0F;
+            const uint32_t offset = (packet[4] << 24) | (packet[5] << 16) | (packet[6] << 8) | packet[7];
+            const uint16_t length = (packet[8] << 8) | packet[9];
+
+            packets++;
+            bytes += len;
+
+            const int expectedSequence = (lastSequence % 15) + 1;
+            if (sequence != 0 && lastSequence != 0 && sequence != expectedSequence) {
+                sequenceGaps++;
+                // Sequence numbers wrap every 15 packets, so this is a lower bound
+                lost += static_cast<uint64_t>((sequence - expectedSequence + 15) % 15);
+            }
+            lastSequence = sequence;
+
+            if (length <= len - DDP_HEADER_SIZE && offset + length <= frameBytes) {
+                memcpy(frame.data() + offset, packet + DDP_HEADER_SIZE, length);
+                bytesThisFrame += length;
+            }
+
+            if (flags & DDP_FLAGS_PUSH) {
+                frames++;
+                if (bytesThisFrame < frameBytes) shortFrames++;
+                bytesThisFrame = 0;
+
+                if (!dumpPath.empty()) {
+                    std::ofstream ppm(dumpPath, std::ios::binary);
+                    ppm << "P6\n" << width << " " << height << "\n255\n";
+                    ppm.write(reinterpret_cast<const char*>(frame.data()), static_cast<std::streamsize>(frameBytes));
+                }
+            }
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastReport >= std::chrono::seconds(1)) {
+            std::cout << "frames/s: " << frames
+                      << "  packets/s: " << packets
+                      << "  KB/s: " << bytes / 1024
+                      << "  seq gaps: " << sequenceGaps
+                      << "  lost: " << lost
+                      << "  incomplete frames: " << shortFrames << std::endl;
+            totalPackets += packets;
+            totalFrames += frames;
+            totalGaps += sequenceGaps;
+            totalLost += lost;
+            totalShortFrames += shortFrames;
+            packets = bytes = frames = sequenceGaps = lost = shortFrames = 0;
+            lastReport = now;
+        }
+    }
+
+    std::cout << "Received " << totalFrames << " frames in " << totalPackets << " packets, "
+              << totalGaps << " sequence gaps, at least " << totalLost << " packets lost ("
+              << (totalPackets + totalLost > 0 ? static_cast<double>(totalLost) * 100.0 / static_cast<double>(totalPackets + totalLost) : 0.0)
+              << "%), " << totalShortFrames << " incomplete frames" << std::endl;
+    close(sock);
+    return 0;
+}